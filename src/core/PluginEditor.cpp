@@ -3,15 +3,16 @@
 RuptureAudioProcessorEditor::RuptureAudioProcessorEditor(RuptureAudioProcessor &p)
     : AudioProcessorEditor(&p),
       audioProcessor(p),
-      layoutView(p.getReverbProcessor())
+      layoutView(p.getReverbProcessor()),
+      refreshScheduler(*this, [this] { return refreshUi(); })
 {
     addAndMakeVisible(layoutView);
 
-    // Initialize the layout view with the output buffer for oscilloscope
-    layoutView.updateBuffer(p.getOutputBuffer());
-
-    // Start the timer for meter updates
-    startTimerHz(30);
+    // Refreshes start once the page is ready and then follow what the user is doing
+    layoutView.onPageReady = [this] { refreshScheduler.setPageReady(); };
+    layoutView.onInteraction = [this] { refreshScheduler.noteInteraction(); };
+    audioProcessor.addChangeListener(this);
+    audioProcessor.setLoudnessMetering(true);
 
     // Set initial size
     setSize(CANVAS_WIDTH, CANVAS_HEIGHT);
@@ -19,7 +20,8 @@ RuptureAudioProcessorEditor::RuptureAudioProcessorEditor(RuptureAudioProcessor &
 
 RuptureAudioProcessorEditor::~RuptureAudioProcessorEditor()
 {
-    stopTimer();
+    audioProcessor.setLoudnessMetering(false);
+    audioProcessor.removeChangeListener(this);
 }
 
 void RuptureAudioProcessorEditor::paint(juce::Graphics &g)
@@ -35,8 +37,15 @@ void RuptureAudioProcessorEditor::resized()
     layoutView.setBounds(bounds);
 }
 
-void RuptureAudioProcessorEditor::timerCallback()
+void RuptureAudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster *)
+{
+    refreshScheduler.wake();
+}
+
+bool RuptureAudioProcessorEditor::refreshUi()
 {
+    layoutView.syncParameters();
+
     // Regular meter updates
     float leftLevel = audioProcessor.getLeftLevel();
     float rightLevel = audioProcessor.getRightLevel();
@@ -68,6 +77,8 @@ void RuptureAudioProcessorEditor::timerCallback()
     // Update the levels in the layout view
     layoutView.updateLevels(leftLevel, rightLevel, outLeftLevel, outRightLevel);
 
-    // Update the oscilloscope with latest audio buffer
-    layoutView.updateBuffer(audioProcessor.getOutputBuffer());
+    const auto loudness = audioProcessor.getLoudnessMeter().getMeasurements();
+    layoutView.updateLoudness(loudness.momentary, loudness.shortTerm, loudness.integrated, loudness.correlation);
+
+    return leftLevel > 0.0f || rightLevel > 0.0f || outLeftLevel > 0.0f || outRightLevel > 0.0f;
 }
\ No newline at end of file
@@ -3,9 +3,10 @@
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
 #include "LayoutView.h"
+#include "RefreshScheduler.h"
 
 class RuptureAudioProcessorEditor : public juce::AudioProcessorEditor,
-                                    private juce::Timer
+                                    private juce::ChangeListener
 {
 public:
     static constexpr int CANVAS_WIDTH = 520;
@@ -22,7 +23,14 @@ private:
 
     LayoutView layoutView;
 
-    void timerCallback() override;
+    // Declared after the view so its timer stops before the view goes away
+    RefreshScheduler refreshScheduler;
+
+    // Meters and parameter sync; returns whether the meters are still moving
+    bool refreshUi();
+
+    // The processor reports sound resuming or a state load
+    void changeListenerCallback(juce::ChangeBroadcaster *source) override;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RuptureAudioProcessorEditor)
 };
\ No newline at end of file
@@ -4,12 +4,16 @@
 RuptureAudioProcessor::RuptureAudioProcessor()
     : AudioProcessor(BusesProperties()
                          .withInput("Input", juce::AudioChannelSet::stereo(), true)
+                         .withInput("Sidechain", juce::AudioChannelSet::stereo(), false)
                          .withOutput("Output", juce::AudioChannelSet::stereo(), true))
 {
 }
 
 RuptureAudioProcessor::~RuptureAudioProcessor()
 {
+    stopTimer();
+    cancelPendingUpdate();
+    backgroundJobs.cancelAll();
 }
 
 const juce::String RuptureAudioProcessor::getName() const
@@ -69,6 +73,10 @@ void RuptureAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock
 
     // Prepare DSP components
     reverbProcessor.prepare(sampleRate, samplesPerBlock);
+    qualityGovernor.prepare(sampleRate);
+    loudnessMeter.prepare(sampleRate, getMainBusNumOutputChannels());
+
+    setLatencySamples(reverbProcessor.getLatencySamples());
 }
 
 void RuptureAudioProcessor::releaseResources()
@@ -87,53 +95,159 @@ bool RuptureAudioProcessor::isBusesLayoutSupported(const BusesLayout &layouts) c
     if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono() && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
         return false;
 
+    // The optional sidechain can be off, mono or stereo
+    if (layouts.inputBuses.size() > 1)
+    {
+        const auto sidechain = layouts.getChannelSet(true, 1);
+        if (!sidechain.isDisabled() && sidechain != juce::AudioChannelSet::mono() && sidechain != juce::AudioChannelSet::stereo())
+            return false;
+    }
+
     return true;
 }
 
 void RuptureAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+    // The sidechain's channels follow the main ones; only the main bus is processed
+    auto mainBuffer = getBusBuffer(buffer, false, 0);
+    auto totalNumInputChannels = getMainBusNumInputChannels();
+    auto totalNumOutputChannels = getMainBusNumOutputChannels();
 
     // Clear output channels that didn't contain input data
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear(i, 0, buffer.getNumSamples());
+        mainBuffer.clear(i, 0, mainBuffer.getNumSamples());
 
     // Calculate input levels for the meters
     float newLevelLeft = 0.0f;
     float newLevelRight = 0.0f;
     if (totalNumInputChannels > 0)
-        newLevelLeft = buffer.getRMSLevel(0, 0, buffer.getNumSamples());
+        newLevelLeft = getRMSLevel(mainBuffer, 0);
     if (totalNumInputChannels > 1)
-        newLevelRight = buffer.getRMSLevel(1, 0, buffer.getNumSamples());
+        newLevelRight = getRMSLevel(mainBuffer, 1);
     levelLeft.setTargetValue(newLevelLeft);
     levelRight.setTargetValue(newLevelRight);
     levelLeft.skip(buffer.getNumSamples());
     levelRight.skip(buffer.getNumSamples());
 
-    // Process audio through reverb
-    reverbProcessor.processBlock(buffer);
+    // Process audio through reverb, keying the ducker from the sidechain when it's connected
+    reverbProcessor.setRenderTier(chooseRenderTier());
+
+    auto *sidechainBus = getBus(true, 1);
+    if (sidechainBus != nullptr && sidechainBus->isEnabled() && sidechainBus->getNumberOfChannels() > 0)
+    {
+        const auto sidechainBuffer = getBusBuffer(buffer, true, 1);
+        reverbProcessor.processBlock(mainBuffer, &sidechainBuffer);
+    }
+    else
+    {
+        reverbProcessor.processBlock(mainBuffer);
+    }
 
     // Calculate output levels after all processing
     float newOutputLevelLeft = 0.0f;
     float newOutputLevelRight = 0.0f;
     if (totalNumOutputChannels > 0)
-        newOutputLevelLeft = buffer.getRMSLevel(0, 0, buffer.getNumSamples());
+        newOutputLevelLeft = getRMSLevel(mainBuffer, 0);
     if (totalNumOutputChannels > 1)
-        newOutputLevelRight = buffer.getRMSLevel(1, 0, buffer.getNumSamples());
+        newOutputLevelRight = getRMSLevel(mainBuffer, 1);
     outputLevelLeft.setTargetValue(newOutputLevelLeft);
     outputLevelRight.setTargetValue(newOutputLevelRight);
     outputLevelLeft.skip(buffer.getNumSamples());
     outputLevelRight.skip(buffer.getNumSamples());
 
-    // Store post-processed buffer for oscilloscope
+    // Tap the output for loudness; the analysis happens on the background pool
+    if (totalNumOutputChannels > 0 && loudnessMetering.load(std::memory_order_relaxed))
+        loudnessMeter.push(mainBuffer.getReadPointer(0),
+                           totalNumOutputChannels > 1 ? mainBuffer.getReadPointer(1) : nullptr,
+                           mainBuffer.getNumSamples());
+
+    // Sound starting again wakes an editor that went quiet in the silence
+    const bool audible = juce::jmax(levelLeft.getCurrentValue(), levelRight.getCurrentValue(),
+                                    juce::jmax(outputLevelLeft.getCurrentValue(), outputLevelRight.getCurrentValue())) > silenceLevel;
+
+    // Tail mode changes can change the latency; tell the host off the audio thread
+    if ((audible && !wasAudible) || reverbProcessor.getLatencySamples() != getLatencySamples())
+        triggerAsyncUpdate();
+
+    wasAudible = audible;
+
+    // Offline renders have no deadline, so only time realtime blocks
+    if (!isNonRealtime())
+    {
+        const auto elapsedTicks = juce::Time::getHighResolutionTicks() - startTicks;
+        qualityGovernor.addMeasurement(juce::Time::highResolutionTicksToSeconds(elapsedTicks),
+                                       mainBuffer.getNumSamples());
+    }
+}
+
+void RuptureAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(reverbProcessor.getLatencySamples());
+    sendChangeMessage();
+}
+
+void RuptureAudioProcessor::setLoudnessMetering(bool shouldMeasure)
+{
+    loudnessMetering = shouldMeasure;
+
+    // Loudness analysis runs a few times within the meter's tap
+    if (shouldMeasure)
+        startTimerHz(10);
+    else
+        stopTimer();
+}
+
+void RuptureAudioProcessor::timerCallback()
+{
+    if (!loudnessMeter.hasPendingSamples() || loudnessJobQueued.exchange(true))
+        return;
+
+    backgroundJobs.submit(WorkerPool::Priority::normal, [this]
+                          {
+                              loudnessMeter.process();
+                              loudnessJobQueued = false;
+                          });
+}
+
+float RuptureAudioProcessor::getRMSLevel(const juce::AudioBuffer<float> &buffer, int channel)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= 0)
+        return 0.0f;
+
+    const float sumOfSquares = DspKernels::get().sumOfSquares(buffer.getReadPointer(channel), numSamples);
+    return std::sqrt(sumOfSquares / static_cast<float>(numSamples));
+}
+
+ReverbTank::QualityTier RuptureAudioProcessor::chooseRenderTier() const
+{
+    // Bouncing always gets the full tank
+    if (isNonRealtime())
+        return ReverbTank::QualityTier::high;
+
+    switch (reverbProcessor.getQualityMode())
     {
-        juce::ScopedLock lock(outputBufferLock);
-        outputBuffer.makeCopyOf(buffer);
+    case ReverbProcessor::QualityMode::eco:
+        return ReverbTank::QualityTier::eco;
+    case ReverbProcessor::QualityMode::normal:
+        return ReverbTank::QualityTier::normal;
+    case ReverbProcessor::QualityMode::automatic:
+        return qualityGovernor.getTier();
+    case ReverbProcessor::QualityMode::high:
+    default:
+        return ReverbTank::QualityTier::high;
     }
 }
 
+ReverbProcessor::MemoryFootprint RuptureAudioProcessor::getMemoryFootprint() const
+{
+    auto footprint = reverbProcessor.getMemoryFootprint();
+    footprint.coreBytes += sizeof(RuptureAudioProcessor) - sizeof(ReverbProcessor);
+    return footprint;
+}
+
 bool RuptureAudioProcessor::hasEditor() const
 {
     return true;
@@ -156,6 +270,28 @@ void RuptureAudioProcessor::getStateInformation(juce::MemoryBlock &destData)
     stream.writeFloat(reverbProcessor.getDryLevel());
     stream.writeFloat(reverbProcessor.getWidth());
     stream.writeFloat(reverbProcessor.getFreezeMode());
+    stream.writeFloat(static_cast<float>(reverbProcessor.getQualityMode()));
+    stream.writeFloat(reverbProcessor.getHalfRateTail() ? 1.0f : 0.0f);
+    stream.writeFloat(reverbProcessor.getLowCut());
+    stream.writeFloat(reverbProcessor.getHighCut());
+    stream.writeFloat(reverbProcessor.getTilt());
+    stream.writeFloat(reverbProcessor.getShimmerAmount());
+    stream.writeFloat(reverbProcessor.getShimmerPitch());
+    stream.writeFloat(reverbProcessor.getDrive());
+    stream.writeFloat(static_cast<float>(reverbProcessor.getDriveOversampling()));
+    stream.writeFloat(static_cast<float>(reverbProcessor.getTailMode()));
+    stream.writeFloat(reverbProcessor.getReverseLength());
+    stream.writeFloat(reverbProcessor.getGateThreshold());
+    stream.writeFloat(reverbProcessor.getGateHold());
+    stream.writeFloat(reverbProcessor.getDuckAmount());
+    stream.writeFloat(reverbProcessor.getDuckThreshold());
+    stream.writeFloat(reverbProcessor.getDuckRelease());
+    stream.writeFloat(reverbProcessor.getCaptureFreeze() ? 1.0f : 0.0f);
+    stream.writeFloat(reverbProcessor.getMidSideMode() ? 1.0f : 0.0f);
+    stream.writeFloat(reverbProcessor.getSideRoomSize());
+    stream.writeFloat(reverbProcessor.getSideDamping());
+    stream.writeFloat(reverbProcessor.getMidLevel());
+    stream.writeFloat(reverbProcessor.getSideLevel());
 }
 
 void RuptureAudioProcessor::setStateInformation(const void *data, int sizeInBytes)
@@ -184,6 +320,66 @@ void RuptureAudioProcessor::setStateInformation(const void *data, int sizeInByte
         reverbProcessor.setWidth(width);
         reverbProcessor.setFreezeMode(freezeMode);
     }
+
+    // Fields added after the original six are optional so older sessions still load
+    if (bytesAvailable >= sizeof(float) * 7)
+    {
+        const int mode = juce::jlimit(0, 3, juce::roundToInt(stream.readFloat()));
+        reverbProcessor.setQualityMode(static_cast<ReverbProcessor::QualityMode>(mode));
+    }
+
+    if (bytesAvailable >= sizeof(float) * 8)
+        reverbProcessor.setHalfRateTail(stream.readFloat() >= 0.5f);
+
+    if (bytesAvailable >= sizeof(float) * 11)
+    {
+        reverbProcessor.setLowCut(stream.readFloat());
+        reverbProcessor.setHighCut(stream.readFloat());
+        reverbProcessor.setTilt(stream.readFloat());
+    }
+
+    if (bytesAvailable >= sizeof(float) * 13)
+    {
+        reverbProcessor.setShimmerAmount(stream.readFloat());
+        reverbProcessor.setShimmerPitch(stream.readFloat());
+    }
+
+    if (bytesAvailable >= sizeof(float) * 15)
+    {
+        reverbProcessor.setDrive(stream.readFloat());
+        reverbProcessor.setDriveOversampling(juce::roundToInt(stream.readFloat()));
+    }
+
+    if (bytesAvailable >= sizeof(float) * 19)
+    {
+        const int mode = juce::jlimit(0, 2, juce::roundToInt(stream.readFloat()));
+        reverbProcessor.setTailMode(static_cast<ReverbProcessor::TailMode>(mode));
+        reverbProcessor.setReverseLength(stream.readFloat());
+        reverbProcessor.setGateThreshold(stream.readFloat());
+        reverbProcessor.setGateHold(stream.readFloat());
+    }
+
+    if (bytesAvailable >= sizeof(float) * 22)
+    {
+        reverbProcessor.setDuckAmount(stream.readFloat());
+        reverbProcessor.setDuckThreshold(stream.readFloat());
+        reverbProcessor.setDuckRelease(stream.readFloat());
+    }
+
+    if (bytesAvailable >= sizeof(float) * 23)
+        reverbProcessor.setCaptureFreeze(stream.readFloat() >= 0.5f);
+
+    if (bytesAvailable >= sizeof(float) * 28)
+    {
+        reverbProcessor.setMidSideMode(stream.readFloat() >= 0.5f);
+        reverbProcessor.setSideRoomSize(stream.readFloat());
+        reverbProcessor.setSideDamping(stream.readFloat());
+        reverbProcessor.setMidLevel(stream.readFloat());
+        reverbProcessor.setSideLevel(stream.readFloat());
+    }
+
+    // Let a quiet editor show the restored values
+    sendChangeMessage();
 }
 
 juce::AudioProcessor *JUCE_CALLTYPE createPluginFilter()
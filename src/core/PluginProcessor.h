@@ -1,9 +1,17 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "LoudnessMeter.h"
 #include "ReverbProcessor.h"
-
-class RuptureAudioProcessor : public juce::AudioProcessor
+#include "QualityGovernor.h"
+#include "WorkerPool.h"
+
+// Broadcasts a change when sound resumes after silence or state is loaded,
+// so an editor whose refreshes have stopped can wake up
+class RuptureAudioProcessor : public juce::AudioProcessor,
+                              public juce::ChangeBroadcaster,
+                              private juce::AsyncUpdater,
+                              private juce::Timer
 {
 public:
     RuptureAudioProcessor();
@@ -37,26 +45,57 @@ public:
 
     ReverbProcessor &getReverbProcessor() { return reverbProcessor; }
 
+    // Loudness and correlation of the output, measured on the background pool.
+    // Without a message loop (e.g. a command-line render) nothing schedules
+    // the analysis, so call process() on it directly.
+    LoudnessMeter &getLoudnessMeter() { return loudnessMeter; }
+
+    // Feeds the meter and schedules its analysis only while something reads
+    // it, so instances nobody is looking at cost nothing. Off by default; the
+    // editor turns it on while open. Message thread.
+    void setLoudnessMetering(bool shouldMeasure);
+
+    // Queue for heavy non-realtime work, backed by the pool shared across instances
+    WorkerPool::Client &getBackgroundJobs() { return backgroundJobs; }
+
     float getLeftLevel() const { return levelLeft.getCurrentValue(); }
     float getRightLevel() const { return levelRight.getCurrentValue(); }
     float getOutputLeftLevel() const { return outputLevelLeft.getCurrentValue(); }
     float getOutputRightLevel() const { return outputLevelRight.getCurrentValue(); }
 
-    juce::AudioBuffer<float> getOutputBuffer()
-    {
-        juce::ScopedLock lock(outputBufferLock);
-        return outputBuffer;
-    }
+    // Approximate bytes held by this instance (object plus DSP heap memory)
+    ReverbProcessor::MemoryFootprint getMemoryFootprint() const;
 
 private:
+    // Smoothed level below which the processor counts as silent
+    static constexpr float silenceLevel = 1.0e-6f;
+
+    // Reports a latency change or resuming sound noticed on the audio thread
+    // from the message thread
+    void handleAsyncUpdate() override;
+
+    // Hands any tapped output to the background pool for loudness analysis
+    void timerCallback() override;
+
+    // Tier to render this block, from the quality mode, governor and render context
+    ReverbTank::QualityTier chooseRenderTier() const;
+
+    // RMS of one channel through the dispatched metering kernel
+    static float getRMSLevel(const juce::AudioBuffer<float> &buffer, int channel);
+
     ReverbProcessor reverbProcessor;
+    QualityGovernor qualityGovernor;
+
+    LoudnessMeter loudnessMeter;
+    std::atomic<bool> loudnessJobQueued{false};
+    std::atomic<bool> loudnessMetering{false};
 
     juce::LinearSmoothedValue<float> levelLeft, levelRight;
     juce::LinearSmoothedValue<float> outputLevelLeft, outputLevelRight;
+    bool wasAudible = false;
 
-    // Buffer for oscilloscope
-    juce::AudioBuffer<float> outputBuffer;
-    juce::CriticalSection outputBufferLock;
+    // Declared last so outstanding jobs are cancelled before anything they use is destroyed
+    WorkerPool::Client backgroundJobs;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RuptureAudioProcessor)
 };
\ No newline at end of file
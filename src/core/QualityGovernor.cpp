@@ -0,0 +1,61 @@
+#include "QualityGovernor.h"
+
+void QualityGovernor::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+    reset();
+}
+
+void QualityGovernor::reset()
+{
+    load = 0.0;
+    blocksOverBudget = 0;
+    secondsUnderBudget = 0.0;
+    tier = ReverbTank::QualityTier::high;
+}
+
+void QualityGovernor::addMeasurement(double processSeconds, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    const double deadline = numSamples / currentSampleRate;
+    const double blockLoad = processSeconds / deadline;
+
+    // Fast attack so spikes register immediately, slow release
+    if (blockLoad > load)
+        load = blockLoad;
+    else
+        load += 0.05 * (blockLoad - load);
+
+    // Steps down on consecutive raw blocks rather than the held load, so a
+    // single spike can't keep the count going long enough to drop two tiers
+    if (blockLoad > stepDownLoad)
+    {
+        secondsUnderBudget = 0.0;
+
+        if (++blocksOverBudget >= stepDownBlocks && tier != ReverbTank::QualityTier::eco)
+        {
+            tier = tier == ReverbTank::QualityTier::high ? ReverbTank::QualityTier::normal
+                                                         : ReverbTank::QualityTier::eco;
+            blocksOverBudget = 0;
+        }
+    }
+    else
+    {
+        blocksOverBudget = 0;
+
+        // Stepping up waits for the held load, which a spike keeps high
+        if (load < stepUpLoad)
+            secondsUnderBudget += deadline;
+        else
+            secondsUnderBudget = 0.0;
+
+        if (secondsUnderBudget >= stepUpSeconds && tier != ReverbTank::QualityTier::high)
+        {
+            tier = tier == ReverbTank::QualityTier::eco ? ReverbTank::QualityTier::normal
+                                                        : ReverbTank::QualityTier::high;
+            secondsUnderBudget = 0.0;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ReverbTank.h"
+
+// Picks the reverb quality tier from how much of each block's deadline
+// processBlock() is using. Steps down quickly when over budget and back up
+// only after a sustained period of headroom, so it doesn't oscillate.
+class QualityGovernor
+{
+public:
+    QualityGovernor() = default;
+    ~QualityGovernor() = default;
+
+    void prepare(double sampleRate);
+    void reset();
+
+    // Feed the wall-clock time spent processing a block of numSamples
+    void addMeasurement(double processSeconds, int numSamples);
+
+    ReverbTank::QualityTier getTier() const { return tier; }
+
+    // Smoothed fraction of the block deadline in use (0 - 1+)
+    double getLoad() const { return load; }
+
+private:
+    // Fraction of the deadline above which we step down, and below which we may step up
+    static constexpr double stepDownLoad = 0.25;
+    static constexpr double stepUpLoad = 0.08;
+
+    // Consecutive over-budget blocks, by their own load, before stepping down
+    static constexpr int stepDownBlocks = 4;
+
+    // Time with headroom required before stepping up
+    static constexpr double stepUpSeconds = 2.0;
+
+    double currentSampleRate = 44100.0;
+    double load = 0.0;
+    int blocksOverBudget = 0;
+    double secondsUnderBudget = 0.0;
+
+    ReverbTank::QualityTier tier = ReverbTank::QualityTier::high;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(QualityGovernor)
+};
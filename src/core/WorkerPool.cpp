@@ -0,0 +1,163 @@
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool()
+{
+    // Leave one core for the host's audio threads
+    const int numWorkers = juce::jmax(1, juce::SystemStats::getNumPhysicalCpus() - 1);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto *worker = workers.add(new Worker(*this, i));
+        worker->startThread(juce::Thread::Priority::low);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    for (auto *worker : workers)
+        worker->signalThreadShouldExit();
+
+    {
+        const juce::ScopedLock lock(queueLock);
+        for (auto &queue : queues)
+            queue.clear();
+    }
+
+    // Wake every worker so it can see the exit flag
+    for (int i = 0; i < workers.size(); ++i)
+        jobAvailable.signal();
+
+    for (auto *worker : workers)
+        worker->stopThread(2000);
+
+    workers.clear();
+}
+
+WorkerPool::ClientId WorkerPool::registerClient()
+{
+    return nextClientId++;
+}
+
+void WorkerPool::submit(ClientId client, Priority priority, Job job)
+{
+    {
+        const juce::ScopedLock lock(queueLock);
+        queues[static_cast<int>(priority)].push_back({client, std::move(job)});
+    }
+
+    jobAvailable.signal();
+}
+
+void WorkerPool::cancelAll(ClientId client)
+{
+    {
+        const juce::ScopedLock lock(queueLock);
+        for (auto &queue : queues)
+            queue.erase(std::remove_if(queue.begin(), queue.end(),
+                                       [client](const QueuedJob &queued)
+                                       { return queued.client == client; }),
+                        queue.end());
+    }
+
+#if JUCE_DEBUG
+    // A job cancelling its own client would wait on itself forever
+    for (auto *worker : workers)
+        jassert(!(worker->runningClient == client && juce::Thread::getCurrentThread() == worker));
+#endif
+
+    while (isRunningJobFor(client))
+        jobFinished.wait(10);
+}
+
+int WorkerPool::getNumPendingJobs() const
+{
+    const juce::ScopedLock lock(queueLock);
+
+    int total = 0;
+    for (auto &queue : queues)
+        total += static_cast<int>(queue.size());
+
+    return total;
+}
+
+bool WorkerPool::popNextJob(Worker &worker, QueuedJob &result)
+{
+    const juce::ScopedLock lock(queueLock);
+
+    // Queues are ordered high to low
+    for (auto &queue : queues)
+    {
+        if (!queue.empty())
+        {
+            result = std::move(queue.front());
+            queue.pop_front();
+
+            // Publish the client under the same lock, so cancelAll() either
+            // removes the job or sees it running, never neither
+            worker.runningClient = result.client;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool WorkerPool::isRunningJobFor(ClientId client) const
+{
+    for (auto *worker : workers)
+        if (worker->runningClient == client)
+            return true;
+
+    return false;
+}
+
+// Worker implementation
+WorkerPool::Worker::Worker(WorkerPool &owner, int index)
+    : juce::Thread("Rupture Worker " + juce::String(index)),
+      pool(owner)
+{
+}
+
+void WorkerPool::Worker::run()
+{
+    while (!threadShouldExit())
+    {
+        QueuedJob next;
+
+        if (!pool.popNextJob(*this, next))
+        {
+            pool.jobAvailable.wait(100);
+            continue;
+        }
+
+        next.job();
+
+        // Release the job's captures before cancelAll() can see it finished;
+        // they may refer to a client that is waiting to be destroyed
+        next.job = nullptr;
+
+        runningClient = 0;
+        pool.jobFinished.signal();
+    }
+}
+
+// Client implementation
+WorkerPool::Client::Client()
+    : id(pool->registerClient())
+{
+}
+
+WorkerPool::Client::~Client()
+{
+    cancelAll();
+}
+
+void WorkerPool::Client::submit(Priority priority, Job job)
+{
+    pool->submit(id, priority, std::move(job));
+}
+
+void WorkerPool::Client::cancelAll()
+{
+    pool->cancelAll(id);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <deque>
+
+// A process-wide pool of background threads shared by every plugin instance.
+// Obtain it through juce::SharedResourcePointer<WorkerPool> (or, more usually,
+// through a WorkerPool::Client) so the threads are created with the first
+// instance and torn down with the last one. The thread count follows the
+// number of cores, not the number of instances.
+class WorkerPool
+{
+public:
+    enum class Priority
+    {
+        high,   // Work the user is waiting on (e.g. loading a preset or IR)
+        normal, // Regular background work (e.g. analysis)
+        low     // Anything that can wait (e.g. cache warming)
+    };
+
+    using Job = std::function<void()>;
+    using ClientId = juce::uint32;
+
+    WorkerPool();
+    ~WorkerPool();
+
+    // Returns a new id used to tag, and later cancel, a group of jobs
+    ClientId registerClient();
+
+    // Queues a job; jobs run in priority order, first-in first-out within a class
+    void submit(ClientId client, Priority priority, Job job);
+
+    // Drops all queued jobs for the client and waits for any of its jobs
+    // that are already running. Must not be called from one of those jobs.
+    void cancelAll(ClientId client);
+
+    int getNumWorkers() const { return workers.size(); }
+    int getNumPendingJobs() const;
+
+    // Per-instance handle: owns a client id on the shared pool and cancels
+    // its outstanding work when destroyed
+    class Client
+    {
+    public:
+        Client();
+        ~Client();
+
+        void submit(Priority priority, Job job);
+        void cancelAll();
+
+    private:
+        juce::SharedResourcePointer<WorkerPool> pool;
+        const ClientId id;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Client)
+    };
+
+private:
+    struct QueuedJob
+    {
+        ClientId client;
+        Job job;
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        Worker(WorkerPool &owner, int index);
+        void run() override;
+
+        std::atomic<ClientId> runningClient{0};
+
+    private:
+        WorkerPool &pool;
+    };
+
+    bool popNextJob(Worker &worker, QueuedJob &result);
+    bool isRunningJobFor(ClientId client) const;
+
+    static constexpr int numPriorities = 3;
+    std::deque<QueuedJob> queues[numPriorities];
+    juce::CriticalSection queueLock;
+
+    juce::WaitableEvent jobAvailable;
+    juce::WaitableEvent jobFinished;
+
+    std::atomic<ClientId> nextClientId{1};
+    juce::OwnedArray<Worker> workers;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WorkerPool)
+};
@@ -0,0 +1,191 @@
+#include "HalfBandFilter.h"
+
+namespace
+{
+    constexpr int historyLength = HalfBand::numPhaseTaps - 1;
+
+    struct CoefficientTable
+    {
+        CoefficientTable()
+        {
+            const int numTaps = 2 * HalfBand::numPhaseTaps - 1;
+            const int centre = (numTaps - 1) / 2;
+            float sum = 0.0f;
+
+            // Windowed sinc at a quarter of the sample rate, keeping only the
+            // even taps; the odd ones (bar the centre) are zero for a half-band
+            for (int j = 0; j < HalfBand::numPhaseTaps; ++j)
+            {
+                const int n = 2 * j;
+                const double x = static_cast<double>(n - centre);
+                const double sinc = std::sin(juce::MathConstants<double>::halfPi * x) /
+                                    (juce::MathConstants<double>::pi * x);
+                const double phase = juce::MathConstants<double>::twoPi * n / (numTaps - 1);
+                const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+
+                coefficients[j] = static_cast<float>(sinc * window);
+                sum += coefficients[j];
+            }
+
+            // The even phase carries exactly half the DC gain, the centre tap the other half
+            for (int j = 0; j < HalfBand::numPhaseTaps; ++j)
+            {
+                coefficients[j] *= 0.5f / sum;
+                interpolationCoefficients[j] = 2.0f * coefficients[j];
+            }
+        }
+
+        float coefficients[HalfBand::numPhaseTaps];
+        float interpolationCoefficients[HalfBand::numPhaseTaps];
+    };
+
+    const CoefficientTable &getCoefficientTable()
+    {
+        static const CoefficientTable table;
+        return table;
+    }
+}
+
+const float *HalfBand::getPhaseCoefficients()
+{
+    return getCoefficientTable().coefficients;
+}
+
+const float *HalfBand::getInterpolationCoefficients()
+{
+    return getCoefficientTable().interpolationCoefficients;
+}
+
+// Decimator implementation
+void HalfBandDecimator::prepare(int maxInputSamples)
+{
+    // One carried sample can add a pair
+    maxOutputSamples = (maxInputSamples + 1) / 2;
+
+    evenHistory.calloc(historyLength + maxOutputSamples);
+    oddHistory.calloc(HalfBand::centreDelay + maxOutputSamples);
+    reset();
+}
+
+void HalfBandDecimator::reset()
+{
+    juce::FloatVectorOperations::clear(evenHistory, historyLength + maxOutputSamples);
+    juce::FloatVectorOperations::clear(oddHistory, HalfBand::centreDelay + maxOutputSamples);
+    pendingSample = 0.0f;
+    hasPendingSample = false;
+}
+
+int HalfBandDecimator::process(const float *input, int numSamples, float *output) noexcept
+{
+    float *even = evenHistory + historyLength;
+    float *odd = oddHistory + HalfBand::centreDelay;
+    int numOutputs = 0;
+    int i = 0;
+
+    // Split into polyphase pairs, completing any pair left open last time
+    if (hasPendingSample && numSamples > 0)
+    {
+        even[numOutputs] = pendingSample;
+        odd[numOutputs++] = input[i++];
+        hasPendingSample = false;
+    }
+
+    for (; i + 1 < numSamples; i += 2)
+    {
+        even[numOutputs] = input[i];
+        odd[numOutputs++] = input[i + 1];
+    }
+
+    if (i < numSamples)
+    {
+        pendingSample = input[i];
+        hasPendingSample = true;
+    }
+
+    jassert(numOutputs <= maxOutputSamples);
+
+    if (numOutputs == 0)
+        return 0;
+
+    // Odd phase is the centre tap: a pure delay
+    juce::FloatVectorOperations::copyWithMultiply(output, oddHistory, 0.5f, numOutputs);
+
+    // Even phase FIR
+    DspKernels::get().firAccumulate(output, even, HalfBand::getPhaseCoefficients(),
+                                    HalfBand::numPhaseTaps, numOutputs);
+
+    // Keep the most recent samples as history for the next block
+    std::memmove(evenHistory, evenHistory + numOutputs, sizeof(float) * historyLength);
+    std::memmove(oddHistory, oddHistory + numOutputs, sizeof(float) * HalfBand::centreDelay);
+
+    return numOutputs;
+}
+
+// Interpolator implementation
+void HalfBandInterpolator::prepare(int maxInputSamples)
+{
+    maxInputs = maxInputSamples;
+
+    history.calloc(historyLength + maxInputs);
+    evenOutput.calloc(maxInputs);
+    oddOutput.calloc(maxInputs);
+    reset();
+}
+
+void HalfBandInterpolator::reset()
+{
+    juce::FloatVectorOperations::clear(history, historyLength + maxInputs);
+
+    // Start one sample ahead so an odd-length request can always be met
+    queuedSample = 0.0f;
+    hasQueuedSample = true;
+}
+
+void HalfBandInterpolator::process(const float *input, int numInputs, float *output, int numOutputs) noexcept
+{
+    jassert(numInputs <= maxInputs);
+    jassert(numOutputs <= 2 * numInputs + (hasQueuedSample ? 1 : 0));
+
+    float *current = history + historyLength;
+    juce::FloatVectorOperations::copy(current, input, numInputs);
+
+    if (numInputs > 0)
+    {
+        // Even outputs come from the FIR phase
+        juce::FloatVectorOperations::clear(evenOutput, numInputs);
+        DspKernels::get().firAccumulate(evenOutput, current, HalfBand::getInterpolationCoefficients(),
+                                        HalfBand::numPhaseTaps, numInputs);
+
+        // Odd outputs are the centre tap, a pure delay
+        juce::FloatVectorOperations::copy(oddOutput, history + historyLength + 1 - HalfBand::centreDelay, numInputs);
+
+        std::memmove(history, history + numInputs, sizeof(float) * historyLength);
+    }
+
+    // Interleave the phases behind the sample queued last time
+    int written = 0;
+    if (hasQueuedSample && written < numOutputs)
+    {
+        output[written++] = queuedSample;
+        hasQueuedSample = false;
+    }
+
+    for (int i = 0; i < numInputs; ++i)
+    {
+        const float pair[2] = {evenOutput[i], oddOutput[i]};
+
+        for (float sample : pair)
+        {
+            if (written < numOutputs)
+            {
+                output[written++] = sample;
+            }
+            else
+            {
+                jassert(!hasQueuedSample);
+                queuedSample = sample;
+                hasQueuedSample = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspKernels.h"
+
+// Polyphase half-band FIR (31 taps, Blackman window) for 2x rate changes.
+// Only the even-phase taps and the centre tap are non-zero, so each stage
+// splits into one short FIR plus a pure delay. The FIR runs through the
+// dispatched DspKernels::firAccumulate, vectorised across output samples.
+namespace HalfBand
+{
+    // Number of non-zero even-phase taps
+    static constexpr int numPhaseTaps = 16;
+
+    // Delay of the centre tap in low-rate samples
+    static constexpr int centreDelay = numPhaseTaps / 2;
+
+    // Even-phase coefficients, computed once and shared by every instance
+    const float *getPhaseCoefficients();
+
+    // The same, scaled by two to make up for the zeros an interpolator inserts
+    const float *getInterpolationCoefficients();
+}
+
+// Halves the sample rate of one channel. Accepts any number of input
+// samples; an odd sample left over is carried into the next call.
+class HalfBandDecimator
+{
+public:
+    HalfBandDecimator() = default;
+    ~HalfBandDecimator() = default;
+
+    void prepare(int maxInputSamples);
+    void reset();
+
+    // Returns the number of low-rate samples written to output
+    int process(const float *input, int numSamples, float *output) noexcept;
+
+private:
+    juce::HeapBlock<float> evenHistory, oddHistory;
+    int maxOutputSamples = 0;
+    float pendingSample = 0.0f;
+    bool hasPendingSample = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HalfBandDecimator)
+};
+
+// Doubles the sample rate of one channel. Every input sample yields two
+// outputs; one spare output is queued between calls, so paired with a
+// HalfBandDecimator it always delivers exactly as many samples as went in.
+class HalfBandInterpolator
+{
+public:
+    HalfBandInterpolator() = default;
+    ~HalfBandInterpolator() = default;
+
+    void prepare(int maxInputSamples);
+    void reset();
+
+    // numOutputs must not exceed the queued sample plus 2 * numInputs
+    void process(const float *input, int numInputs, float *output, int numOutputs) noexcept;
+
+private:
+    juce::HeapBlock<float> history, evenOutput, oddOutput;
+    int maxInputs = 0;
+    float queuedSample = 0.0f;
+    bool hasQueuedSample = true;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HalfBandInterpolator)
+};
@@ -0,0 +1,198 @@
+#include "WetToneFilter.h"
+
+namespace
+{
+    constexpr double minLowCut = 20.0;
+    constexpr double maxLowCut = 2000.0;
+    constexpr double minHighCut = 1000.0;
+    constexpr double maxHighCut = 20000.0;
+    constexpr double tiltFrequency = 1000.0;
+    constexpr double maxTiltDb = 6.0;
+
+    // Butterworth sections
+    constexpr double filterQ = 0.70710678118654752;
+
+    double mapLogarithmic(float amount, double minimum, double maximum)
+    {
+        return minimum * std::pow(maximum / minimum, static_cast<double>(amount));
+    }
+
+    // State level below which a faded-out stage can be dropped unheard
+    constexpr float drainedLevel = 1.0e-6f;
+
+    StereoBiquadCascade::Coefficients normalise(double b0, double b1, double b2, double a0, double a1, double a2)
+    {
+        return {static_cast<float>(b0 / a0), static_cast<float>(b1 / a0), static_cast<float>(b2 / a0),
+                static_cast<float>(a1 / a0), static_cast<float>(a2 / a0)};
+    }
+}
+
+WetToneFilter::WetToneFilter()
+{
+    lowCutAmount.setCurrentAndTargetValue(0.0f);
+    highCutAmount.setCurrentAndTargetValue(1.0f);
+    tiltAmount.setCurrentAndTargetValue(0.5f);
+
+    for (auto &mix : stageMix)
+        mix.setCurrentAndTargetValue(0.0f);
+}
+
+void WetToneFilter::prepare(double sampleRate)
+{
+    currentSampleRate = sampleRate;
+
+    const double smoothTime = 0.05;
+    lowCutAmount.reset(sampleRate, smoothTime);
+    highCutAmount.reset(sampleRate, smoothTime);
+    tiltAmount.reset(sampleRate, smoothTime);
+
+    // Stages fade over the same time as the controls, starting fully in or out
+    reset();
+    updateCoefficients();
+    for (auto &mix : stageMix)
+    {
+        mix.reset(sampleRate, smoothTime);
+        mix.setCurrentAndTargetValue(mix.getTargetValue());
+    }
+    updateCoefficients();
+}
+
+void WetToneFilter::reset()
+{
+    for (auto &state : cascade.state)
+        std::fill(std::begin(state), std::end(state), 0.0f);
+}
+
+void WetToneFilter::setParameters(float lowCut, float highCut, float tilt)
+{
+    lowCutAmount.setTargetValue(lowCut);
+    highCutAmount.setTargetValue(highCut);
+    tiltAmount.setTargetValue(tilt);
+    coefficientsNeedUpdate = true;
+}
+
+void WetToneFilter::process(float *left, float *right, int numSamples) noexcept
+{
+    // Step the controls once per call and only redesign while they move
+    if (coefficientsNeedUpdate || lowCutAmount.isSmoothing() || highCutAmount.isSmoothing() || tiltAmount.isSmoothing())
+    {
+        lowCutAmount.skip(numSamples);
+        highCutAmount.skip(numSamples);
+        tiltAmount.skip(numSamples);
+        for (auto &mix : stageMix)
+            mix.skip(numSamples);
+        updateCoefficients();
+    }
+
+    for (bool active : cascade.active)
+    {
+        if (active)
+        {
+            DspKernels::get().biquadCascade(cascade, left, right, numSamples);
+            return;
+        }
+    }
+}
+
+void WetToneFilter::updateCoefficients()
+{
+    bool draining = false;
+
+    const float lowCut = lowCutAmount.getCurrentValue();
+    draining |= updateStage(lowCutStage, lowCut > 0.0f,
+                            makeHighPass(mapLogarithmic(lowCut, minLowCut, maxLowCut), currentSampleRate));
+
+    const float highCut = highCutAmount.getCurrentValue();
+    draining |= updateStage(highCutStage, highCut < 1.0f,
+                            makeLowPass(mapLogarithmic(1.0f - highCut, maxHighCut, minHighCut), currentSampleRate));
+
+    const double tiltDb = (tiltAmount.getCurrentValue() - 0.5) * 2.0 * maxTiltDb;
+    const bool tilted = std::abs(tiltDb) > 0.01;
+    draining |= updateStage(lowShelfStage, tilted, makeShelf(tiltFrequency, -0.5 * tiltDb, false, currentSampleRate));
+    draining |= updateStage(highShelfStage, tilted, makeShelf(tiltFrequency, 0.5 * tiltDb, true, currentSampleRate));
+
+    bool fading = false;
+    for (auto &mix : stageMix)
+        fading |= mix.isSmoothing();
+
+    coefficientsNeedUpdate = draining || fading || lowCutAmount.isSmoothing() || highCutAmount.isSmoothing() ||
+                             tiltAmount.isSmoothing();
+}
+
+bool WetToneFilter::updateStage(int stage, bool shouldBeActive, const StereoBiquadCascade::Coefficients &design)
+{
+    auto &mix = stageMix[stage];
+    mix.setTargetValue(shouldBeActive ? 1.0f : 0.0f);
+
+    const float amount = mix.getCurrentValue();
+
+    if (amount <= 0.0f && !cascade.active[stage])
+        return false;
+
+    // Fade inside the section: the poles stay at the design and the zeros
+    // move from cancelling them (a unity response) to the design, which is
+    // a dry/wet crossfade of the stage without disturbing its state
+    cascade.coefficients[stage] = {1.0f + amount * (design.b0 - 1.0f),
+                                   design.a1 + amount * (design.b1 - design.a1),
+                                   design.a2 + amount * (design.b2 - design.a2),
+                                   design.a1,
+                                   design.a2};
+
+    if (amount > 0.0f)
+    {
+        cascade.active[stage] = true;
+        return false;
+    }
+
+    // Faded out: the stage passes its input through while the state rings
+    // down, and drops out once that is inaudible
+    const auto &state = cascade.state[stage];
+    const float remaining = juce::jmax(std::abs(state[0]), std::abs(state[1]), std::abs(state[2]), std::abs(state[3]));
+
+    if (remaining > drainedLevel)
+        return true;
+
+    cascade.active[stage] = false;
+    std::fill(std::begin(cascade.state[stage]), std::end(cascade.state[stage]), 0.0f);
+    return false;
+}
+
+// RBJ cookbook designs, in double precision to keep low cutoffs stable
+StereoBiquadCascade::Coefficients WetToneFilter::makeHighPass(double frequency, double sampleRate)
+{
+    const double w0 = juce::MathConstants<double>::twoPi * juce::jmin(frequency, 0.45 * sampleRate) / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * filterQ);
+
+    return normalise((1.0 + cosW0) * 0.5, -(1.0 + cosW0), (1.0 + cosW0) * 0.5,
+                     1.0 + alpha, -2.0 * cosW0, 1.0 - alpha);
+}
+
+StereoBiquadCascade::Coefficients WetToneFilter::makeLowPass(double frequency, double sampleRate)
+{
+    const double w0 = juce::MathConstants<double>::twoPi * juce::jmin(frequency, 0.45 * sampleRate) / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * filterQ);
+
+    return normalise((1.0 - cosW0) * 0.5, 1.0 - cosW0, (1.0 - cosW0) * 0.5,
+                     1.0 + alpha, -2.0 * cosW0, 1.0 - alpha);
+}
+
+StereoBiquadCascade::Coefficients WetToneFilter::makeShelf(double frequency, double gainDb, bool highShelf, double sampleRate)
+{
+    const double a = std::pow(10.0, gainDb / 40.0);
+    const double w0 = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+    const double cosW0 = std::cos(w0);
+    const double beta = 2.0 * std::sqrt(a) * std::sin(w0) / (2.0 * filterQ);
+
+    // The high shelf is the low shelf with the sign of cos(w0) flipped
+    const double c = highShelf ? -cosW0 : cosW0;
+    const double sign = highShelf ? -1.0 : 1.0;
+
+    return normalise(a * ((a + 1.0) - (a - 1.0) * c + beta),
+                     sign * 2.0 * a * ((a - 1.0) - (a + 1.0) * c),
+                     a * ((a + 1.0) - (a - 1.0) * c - beta),
+                     (a + 1.0) + (a - 1.0) * c + beta,
+                     sign * -2.0 * ((a - 1.0) + (a + 1.0) * c),
+                     (a + 1.0) + (a - 1.0) * c - beta);
+}
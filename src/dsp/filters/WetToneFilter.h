@@ -0,0 +1,60 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspKernels.h"
+
+// Tone shaping for the wet pair: a low cut, a high cut and a tilt around
+// 1kHz, run as one stereo biquad cascade through DspKernels::biquadCascade.
+// Controls are smoothed per call and coefficients are only recomputed
+// while a control is moving. Stages at their neutral setting are skipped;
+// they fade in and out through a unity response so switching is silent.
+class WetToneFilter
+{
+public:
+    WetToneFilter();
+    ~WetToneFilter() = default;
+
+    void prepare(double sampleRate);
+    void reset();
+
+    // Normalised controls, 0.0 - 1.0:
+    //   lowCut  0 is off, otherwise 20Hz - 2kHz (12dB/oct)
+    //   highCut 1 is off, otherwise 20kHz - 1kHz (12dB/oct)
+    //   tilt    0.5 is flat, 0 is +3dB/-3dB low/high shelves at 1kHz (6dB of
+    //           tilt), 1 the reverse
+    void setParameters(float lowCut, float highCut, float tilt);
+
+    // Filters the pair in place; keep calls short (a sub-block) so control
+    // changes are stepped finely enough
+    void process(float *left, float *right, int numSamples) noexcept;
+
+private:
+    enum Stage
+    {
+        lowCutStage,
+        highCutStage,
+        lowShelfStage,
+        highShelfStage
+    };
+
+    void updateCoefficients();
+
+    // Blends the stage between a unity response and the design as it fades
+    // in or out. Returns true while a faded-out stage still drains its state.
+    bool updateStage(int stage, bool shouldBeActive, const StereoBiquadCascade::Coefficients &design);
+
+    static StereoBiquadCascade::Coefficients makeHighPass(double frequency, double sampleRate);
+    static StereoBiquadCascade::Coefficients makeLowPass(double frequency, double sampleRate);
+    static StereoBiquadCascade::Coefficients makeShelf(double frequency, double gainDb, bool highShelf, double sampleRate);
+
+    StereoBiquadCascade cascade;
+    double currentSampleRate = 44100.0;
+    bool coefficientsNeedUpdate = true;
+
+    juce::LinearSmoothedValue<float> lowCutAmount, highCutAmount, tiltAmount;
+
+    // How far each stage is faded in from unity
+    juce::LinearSmoothedValue<float> stageMix[StereoBiquadCascade::maxStages];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WetToneFilter)
+};
@@ -0,0 +1,239 @@
+#include "LoudnessMeter.h"
+
+namespace
+{
+    // Tap capacity; the consumer runs several times within it
+    constexpr double tapSeconds = 0.5;
+
+    // BS.1770 K-weighting at any rate: a high shelf for the head, then the
+    // RLB high pass. Same parameterisation as libebur128.
+    StereoBiquadCascade::Coefficients makePreFilter(double sampleRate)
+    {
+        const double f0 = 1681.974450955533;
+        const double gainDb = 3.999843853973347;
+        const double q = 0.7071752369554196;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double vh = std::pow(10.0, gainDb / 20.0);
+        const double vb = std::pow(vh, 0.4996667741545416);
+        const double a0 = 1.0 + k / q + k * k;
+
+        return {static_cast<float>((vh + vb * k / q + k * k) / a0),
+                static_cast<float>(2.0 * (k * k - vh) / a0),
+                static_cast<float>((vh - vb * k / q + k * k) / a0),
+                static_cast<float>(2.0 * (k * k - 1.0) / a0),
+                static_cast<float>((1.0 - k / q + k * k) / a0)};
+    }
+
+    StereoBiquadCascade::Coefficients makeRlbFilter(double sampleRate)
+    {
+        const double f0 = 38.13547087602444;
+        const double q = 0.5003270373238773;
+
+        const double k = std::tan(juce::MathConstants<double>::pi * f0 / sampleRate);
+        const double a0 = 1.0 + k / q + k * k;
+
+        return {1.0f, -2.0f, 1.0f,
+                static_cast<float>(2.0 * (k * k - 1.0) / a0),
+                static_cast<float>((1.0 - k / q + k * k) / a0)};
+    }
+}
+
+void LoudnessMeter::prepare(double sampleRate, int numChannels)
+{
+    // Take the consumer's flag so a background drain can't run meanwhile
+    while (processing.exchange(true))
+        juce::Thread::yield();
+
+    const int capacity = juce::roundToInt(tapSeconds * sampleRate);
+    fifo.setTotalSize(capacity);
+    fifo.reset();
+
+    for (auto &channel : tap)
+        channel.calloc(capacity);
+    for (auto &channel : scratch)
+        channel.calloc(chunkSize);
+
+    stereo = numChannels > 1;
+    segmentLength = juce::roundToInt(0.1 * sampleRate);
+
+    kWeighting = {};
+    kWeighting.coefficients[0] = makePreFilter(sampleRate);
+    kWeighting.coefficients[1] = makeRlbFilter(sampleRate);
+    kWeighting.active[0] = true;
+    kWeighting.active[1] = true;
+
+    segmentPosition = 0;
+    current = {};
+    std::fill(std::begin(history), std::end(history), Segment{});
+    historyIndex = 0;
+    numSegments = 0;
+
+    std::fill(std::begin(binEnergy), std::end(binEnergy), 0.0);
+    std::fill(std::begin(binCount), std::end(binCount), 0);
+
+    momentary = minLoudness;
+    shortTerm = minLoudness;
+    integrated = minLoudness;
+    correlation = 0.0f;
+
+    processing = false;
+}
+
+void LoudnessMeter::push(const float *left, const float *right, int numSamples) noexcept
+{
+    if (fifo.getFreeSpace() < numSamples)
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(numSamples, start1, size1, start2, size2);
+
+    juce::FloatVectorOperations::copy(tap[0] + start1, left, size1);
+    juce::FloatVectorOperations::copy(tap[0] + start2, left + size1, size2);
+
+    const float *second = right != nullptr ? right : left;
+    juce::FloatVectorOperations::copy(tap[1] + start1, second, size1);
+    juce::FloatVectorOperations::copy(tap[1] + start2, second + size1, size2);
+
+    fifo.finishedWrite(size1 + size2);
+}
+
+void LoudnessMeter::process()
+{
+    if (processing.exchange(true))
+        return;
+
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(fifo.getNumReady(), start1, size1, start2, size2);
+
+    analyse(start1, size1);
+    analyse(start2, size2);
+
+    fifo.finishedRead(size1 + size2);
+    processing = false;
+}
+
+void LoudnessMeter::analyse(int start, int numSamples)
+{
+    const auto &kernels = DspKernels::get();
+
+    for (int offset = 0; offset < numSamples;)
+    {
+        const int count = juce::jmin(numSamples - offset, chunkSize, segmentLength - segmentPosition);
+        const float *left = tap[0] + start + offset;
+        const float *right = tap[1] + start + offset;
+
+        // Correlation from the unweighted pair; the cross term comes from the
+        // sum and difference so it runs through the same squaring kernel
+        juce::FloatVectorOperations::add(scratch[0], left, right, count);
+        juce::FloatVectorOperations::subtract(scratch[1], left, right, count);
+        current.cross += 0.25 * (kernels.sumOfSquares(scratch[0], count) - kernels.sumOfSquares(scratch[1], count));
+        current.leftSquares += kernels.sumOfSquares(left, count);
+        current.rightSquares += kernels.sumOfSquares(right, count);
+
+        // Both channels are K-weighted in one pass
+        juce::FloatVectorOperations::copy(scratch[0], left, count);
+        juce::FloatVectorOperations::copy(scratch[1], right, count);
+        kernels.biquadCascade(kWeighting, scratch[0], scratch[1], count);
+
+        current.energy += kernels.sumOfSquares(scratch[0], count);
+        if (stereo)
+            current.energy += kernels.sumOfSquares(scratch[1], count);
+
+        offset += count;
+        segmentPosition += count;
+
+        if (segmentPosition >= segmentLength)
+            finishSegment();
+    }
+}
+
+void LoudnessMeter::finishSegment()
+{
+    current.energy /= segmentLength;
+    history[historyIndex] = current;
+    historyIndex = (historyIndex + 1) % shortTermSegments;
+    numSegments = juce::jmin(numSegments + 1, shortTermSegments);
+
+    current = {};
+    segmentPosition = 0;
+
+    // Newest segments first
+    Segment momentarySum, shortTermSum;
+    for (int i = 0; i < numSegments; ++i)
+    {
+        const auto &segment = history[(historyIndex - 1 - i + shortTermSegments) % shortTermSegments];
+
+        if (i < momentarySegments)
+        {
+            momentarySum.energy += segment.energy;
+            momentarySum.leftSquares += segment.leftSquares;
+            momentarySum.rightSquares += segment.rightSquares;
+            momentarySum.cross += segment.cross;
+        }
+
+        shortTermSum.energy += segment.energy;
+    }
+
+    const double momentaryEnergy = momentarySum.energy / juce::jmin(numSegments, momentarySegments);
+    momentary = energyToLoudness(momentaryEnergy);
+    shortTerm = energyToLoudness(shortTermSum.energy / numSegments);
+
+    const double power = std::sqrt(momentarySum.leftSquares * momentarySum.rightSquares);
+    correlation = power > 1.0e-12 ? static_cast<float>(juce::jlimit(-1.0, 1.0, momentarySum.cross / power)) : 0.0f;
+
+    // Every full 400ms block, one per 100ms hop, goes into the gating histogram
+    if (numSegments >= momentarySegments)
+    {
+        const float blockLoudness = energyToLoudness(momentaryEnergy);
+        if (blockLoudness > absoluteGate)
+        {
+            const int bin = juce::jlimit(0, numBins - 1, static_cast<int>((blockLoudness - absoluteGate) * binsPerLu));
+            binEnergy[bin] += momentaryEnergy;
+            ++binCount[bin];
+        }
+
+        integrated = computeIntegrated();
+    }
+}
+
+float LoudnessMeter::computeIntegrated() const
+{
+    // Mean over blocks above the absolute gate sets the relative gate
+    double energySum = 0.0;
+    juce::int64 count = 0;
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        energySum += binEnergy[bin];
+        count += binCount[bin];
+    }
+
+    if (count == 0)
+        return minLoudness;
+
+    const float threshold = energyToLoudness(energySum / static_cast<double>(count)) + relativeGate;
+    const int firstBin = juce::jlimit(0, numBins, static_cast<int>(std::ceil((threshold - absoluteGate) * binsPerLu)));
+
+    energySum = 0.0;
+    count = 0;
+    for (int bin = firstBin; bin < numBins; ++bin)
+    {
+        energySum += binEnergy[bin];
+        count += binCount[bin];
+    }
+
+    return count > 0 ? energyToLoudness(energySum / static_cast<double>(count)) : minLoudness;
+}
+
+float LoudnessMeter::energyToLoudness(double energy)
+{
+    if (energy <= 0.0)
+        return minLoudness;
+
+    return juce::jmax(minLoudness, static_cast<float>(-0.691 + 10.0 * std::log10(energy)));
+}
+
+LoudnessMeter::Measurements LoudnessMeter::getMeasurements() const
+{
+    return {momentary.load(), shortTerm.load(), integrated.load(), correlation.load()};
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DspKernels.h"
+
+// ITU-R BS.1770 loudness (momentary, short-term and gated integrated) and
+// L/R phase correlation of the plugin's output. The audio thread only copies
+// each block into a lock-free tap; process() drains it on a background thread,
+// K-weighting both channels at once through the dispatched biquad kernel and
+// summing energies with the dispatched sum-of-squares kernel. Integrated
+// loudness gates a histogram of 400ms block loudnesses, so memory stays fixed
+// however long it runs.
+class LoudnessMeter
+{
+public:
+    // Reported for silence and anything quieter
+    static constexpr float minLoudness = -100.0f;
+
+    struct Measurements
+    {
+        float momentary = minLoudness;  // LUFS over the last 400ms
+        float shortTerm = minLoudness;  // LUFS over the last 3s
+        float integrated = minLoudness; // Gated LUFS of all pushed since prepare()
+        float correlation = 0.0f;       // -1 - +1 over the last 400ms, 0 in silence
+    };
+
+    LoudnessMeter() = default;
+    ~LoudnessMeter() = default;
+
+    // Allocates the tap and clears every measurement. Not realtime safe and
+    // must not overlap push(); waits for any process() call to finish.
+    void prepare(double sampleRate, int numChannels);
+
+    // Audio thread. A mono block passes null for the right channel. Blocks
+    // that don't fit because the consumer has fallen behind are dropped.
+    void push(const float *left, const float *right, int numSamples) noexcept;
+
+    bool hasPendingSamples() const { return fifo.getNumReady() > 0; }
+
+    // Any non-audio thread. Only one caller does the work at a time; a
+    // concurrent call returns straight away.
+    void process();
+
+    // Latest values, readable from any thread
+    Measurements getMeasurements() const;
+
+private:
+    // Gating histogram: 0.1 LU bins from the absolute gate up
+    static constexpr float absoluteGate = -70.0f;
+    static constexpr float relativeGate = -10.0f;
+    static constexpr float binsPerLu = 10.0f;
+    static constexpr int numBins = 800;
+
+    // Segments are 100ms; momentary spans 4, short-term 30
+    static constexpr int momentarySegments = 4;
+    static constexpr int shortTermSegments = 30;
+
+    // Longest run filtered in one go
+    static constexpr int chunkSize = 1024;
+
+    struct Segment
+    {
+        double energy = 0.0; // Mean square of the K-weighted channels, summed
+        double leftSquares = 0.0;
+        double rightSquares = 0.0;
+        double cross = 0.0;
+    };
+
+    static float energyToLoudness(double energy);
+
+    void analyse(int start, int numSamples);
+    void finishSegment();
+    float computeIntegrated() const;
+
+    juce::AbstractFifo fifo{1};
+    juce::HeapBlock<float> tap[2];
+
+    juce::HeapBlock<float> scratch[2];
+    StereoBiquadCascade kWeighting;
+    bool stereo = true;
+
+    int segmentLength = 4800;
+    int segmentPosition = 0;
+    Segment current;
+    Segment history[shortTermSegments];
+    int historyIndex = 0;
+    int numSegments = 0;
+
+    double binEnergy[numBins] = {};
+    juce::int64 binCount[numBins] = {};
+
+    std::atomic<bool> processing{false};
+
+    std::atomic<float> momentary{minLoudness};
+    std::atomic<float> shortTerm{minLoudness};
+    std::atomic<float> integrated{minLoudness};
+    std::atomic<float> correlation{0.0f};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessMeter)
+};
@@ -0,0 +1,40 @@
+#include "DelayArena.h"
+
+size_t DelayArena::paddedSize(int numFloats)
+{
+    const auto size = static_cast<size_t>(juce::jmax(0, numFloats));
+    return (size + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+}
+
+void DelayArena::allocate(size_t numFloats)
+{
+    capacity = numFloats;
+    used = 0;
+
+    // Over-allocate by one line so the start can be aligned by hand
+    storage.calloc(capacity * sizeof(float) + alignmentBytes);
+
+    const auto address = reinterpret_cast<uintptr_t>(storage.get());
+    const auto aligned = (address + alignmentBytes - 1) & ~static_cast<uintptr_t>(alignmentBytes - 1);
+    base = reinterpret_cast<float *>(aligned);
+}
+
+float *DelayArena::carve(int numFloats)
+{
+    const size_t size = paddedSize(numFloats);
+
+    // The layout pass must have reserved everything that gets carved
+    jassert(used + size <= capacity);
+    if (used + size > capacity)
+        return nullptr;
+
+    float *slice = base + used;
+    used += size;
+    return slice;
+}
+
+void DelayArena::rewind(size_t mark)
+{
+    jassert(mark <= used);
+    used = juce::jmin(mark, used);
+}
\ No newline at end of file
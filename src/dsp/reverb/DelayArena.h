@@ -0,0 +1,42 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// One contiguous, cache-line aligned block of floats that all of an
+// instance's delay lines and scratch buffers are carved from. The layout is
+// built in two passes: sum paddedSize() over every slice to learn the total,
+// then allocate() once and carve() the slices.
+class DelayArena
+{
+public:
+    static constexpr size_t alignmentBytes = 64;
+    static constexpr size_t floatsPerLine = alignmentBytes / sizeof(float);
+
+    DelayArena() = default;
+    ~DelayArena() = default;
+
+    // Number of floats a slice occupies once padded to a whole cache line
+    static size_t paddedSize(int numFloats);
+
+    // Frees any previous block and allocates a zeroed one of the given size.
+    // Not realtime safe; call from prepare().
+    void allocate(size_t numFloats);
+
+    // Returns the next slice; slices always start on a cache line
+    float *carve(int numFloats);
+
+    // Current carve position; rewinding to it lets the slices after it be
+    // re-laid out (e.g. for another sample rate) without reallocating
+    size_t getMark() const { return used; }
+    void rewind(size_t mark);
+
+    size_t getSizeInBytes() const { return capacity * sizeof(float); }
+
+private:
+    juce::HeapBlock<char> storage;
+    float *base = nullptr;
+    size_t capacity = 0;
+    size_t used = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DelayArena)
+};
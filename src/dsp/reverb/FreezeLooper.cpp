@@ -0,0 +1,215 @@
+#include "FreezeLooper.h"
+
+namespace
+{
+    constexpr double loopSeconds = 3.0;
+    constexpr double fadeSeconds = 0.2;
+
+    // Long enough for the tank's feedback and damping to reach their frozen values
+    constexpr double settleSeconds = 0.05;
+}
+
+int FreezeLooper::getLoopLength(double sampleRate)
+{
+    return juce::roundToInt(loopSeconds * sampleRate);
+}
+
+int FreezeLooper::getFadeLength(double sampleRate)
+{
+    return juce::roundToInt(fadeSeconds * sampleRate);
+}
+
+size_t FreezeLooper::getRequiredArenaSize(double sampleRate)
+{
+    return 2 * DelayArena::paddedSize(getLoopLength(sampleRate)) +
+           DelayArena::paddedSize(getFadeLength(sampleRate));
+}
+
+void FreezeLooper::prepare(double sampleRate, DelayArena &arena)
+{
+    loopLength = getLoopLength(sampleRate);
+    fadeLength = getFadeLength(sampleRate);
+    settleLength = juce::roundToInt(settleSeconds * sampleRate);
+
+    // The loop isn't cleared; only a capture touches its pages
+    loop[0] = arena.carve(loopLength);
+    loop[1] = arena.carve(loopLength);
+    fadeIn = arena.carve(fadeLength);
+    recordedLength = 0;
+
+    // Equal-power: the tank and the loop are uncorrelated, so their powers add.
+    // The matching fade out is the table read backwards.
+    for (int i = 0; i < fadeLength; ++i)
+        fadeIn[i] = std::sin(juce::MathConstants<float>::halfPi * (static_cast<float>(i) + 0.5f) / static_cast<float>(fadeLength));
+
+    reset();
+}
+
+size_t FreezeLooper::getTouchedArenaSize() const
+{
+    return 2 * DelayArena::paddedSize(recordedLength) + DelayArena::paddedSize(fadeLength);
+}
+
+void FreezeLooper::reset()
+{
+    state = State::idle;
+    progress = 0;
+    loopPosition = 0;
+    releasePosition = 0;
+}
+
+void FreezeLooper::setEngaged(bool shouldBeEngaged)
+{
+    engaged = shouldBeEngaged;
+}
+
+void FreezeLooper::startRelease(int fadePosition)
+{
+    state = State::releasing;
+    releasePosition = fadePosition;
+}
+
+void FreezeLooper::process(float *left, float *right, int numSamples) noexcept
+{
+    if (loopLength == 0)
+        return;
+
+    float *channels[2] = {left, right};
+
+    for (int i = 0; i < numSamples;)
+    {
+        const int remaining = numSamples - i;
+
+        switch (state)
+        {
+        case State::idle:
+            if (!engaged)
+                return;
+
+            state = State::settling;
+            progress = 0;
+            break;
+
+        case State::settling:
+        {
+            if (!engaged)
+            {
+                state = State::idle;
+                return;
+            }
+
+            const int count = juce::jmin(remaining, settleLength - progress);
+            progress += count;
+            i += count;
+
+            if (progress >= settleLength)
+            {
+                state = State::capturing;
+                progress = 0;
+            }
+            break;
+        }
+
+        case State::capturing:
+        {
+            if (progress < loopLength)
+            {
+                // Plain recording; the tank is still heard
+                if (!engaged)
+                {
+                    state = State::idle;
+                    return;
+                }
+
+                const int count = juce::jmin(remaining, loopLength - progress);
+                for (int channel = 0; channel < 2; ++channel)
+                    juce::FloatVectorOperations::copy(loop[channel] + progress, channels[channel] + i, count);
+
+                progress += count;
+                i += count;
+
+                if (progress > recordedLength)
+                    recordedLength = progress;
+                break;
+            }
+
+            // The live tank fades into the loop's start, and what's heard is
+            // written back as the start, so the loop wraps onto live material
+            const int fadePosition = progress - loopLength;
+
+            if (!engaged)
+            {
+                // Carry on from the same balance of loop and tank
+                loopPosition = fadePosition;
+                startRelease(fadeLength - 1 - fadePosition);
+                break;
+            }
+
+            const int count = juce::jmin(remaining, fadeLength - fadePosition);
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                float *start = loop[channel] + fadePosition;
+                float *live = channels[channel] + i;
+
+                for (int n = 0; n < count; ++n)
+                {
+                    const float blended = start[n] * fadeIn[fadePosition + n] + live[n] * fadeIn[fadeLength - 1 - fadePosition - n];
+                    start[n] = blended;
+                    live[n] = blended;
+                }
+            }
+
+            progress += count;
+            i += count;
+
+            if (progress >= loopLength + fadeLength)
+            {
+                state = State::looping;
+                loopPosition = fadeLength % loopLength;
+            }
+            break;
+        }
+
+        case State::looping:
+        {
+            if (!engaged)
+            {
+                startRelease(0);
+                break;
+            }
+
+            const int count = juce::jmin(remaining, loopLength - loopPosition);
+            for (int channel = 0; channel < 2; ++channel)
+                juce::FloatVectorOperations::copy(channels[channel] + i, loop[channel] + loopPosition, count);
+
+            loopPosition = (loopPosition + count) % loopLength;
+            i += count;
+            break;
+        }
+
+        case State::releasing:
+        {
+            const int count = juce::jmin(remaining, loopLength - loopPosition, fadeLength - releasePosition);
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                const float *looped = loop[channel] + loopPosition;
+                float *live = channels[channel] + i;
+
+                for (int n = 0; n < count; ++n)
+                    live[n] = live[n] * fadeIn[releasePosition + n] + looped[n] * fadeIn[fadeLength - 1 - releasePosition - n];
+            }
+
+            loopPosition = (loopPosition + count) % loopLength;
+            releasePosition += count;
+            i += count;
+
+            if (releasePosition >= fadeLength)
+            {
+                state = State::idle;
+                progress = 0;
+            }
+            break;
+        }
+        }
+    }
+}
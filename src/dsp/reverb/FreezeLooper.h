@@ -0,0 +1,76 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayArena.h"
+
+// Stands in for a frozen tank. Once engaged it lets the tank settle, then
+// records a few seconds of its output; over the last part of the recording
+// the live tank is crossfaded into the start of the loop, which becomes the
+// loop's own seam. From then on the loop alone supplies the wet pair and the
+// tank can sleep. Releasing crossfades from the loop back to the live tank.
+// The loop is carved for every instance but never cleared, so its pages
+// are only touched, a little at a time, by the first capture.
+class FreezeLooper
+{
+public:
+    FreezeLooper() = default;
+    ~FreezeLooper() = default;
+
+    // Floats of arena space prepare() will carve at this sample rate
+    static size_t getRequiredArenaSize(double sampleRate);
+
+    void prepare(double sampleRate, DelayArena &arena);
+
+    // Drops any loop and hands straight back to the tank
+    void reset();
+
+    // Audio thread only. Engaging during a release waits for it to finish.
+    void setEngaged(bool shouldBeEngaged);
+
+    // True while the loop alone will supply the next block, so the tank can
+    // sleep through it. A pending release needs the tank awake again.
+    bool isLooping() const { return state == State::looping && engaged; }
+
+    // Records, replaces or crossfades the tank's wet pair depending on state.
+    // While looping the pair's contents are ignored and overwritten.
+    void process(float *left, float *right, int numSamples) noexcept;
+
+    // Floats of arena space written since prepare(): the fade table plus as
+    // much of the loop as has been recorded. Safe to call from any thread.
+    size_t getTouchedArenaSize() const;
+
+private:
+    enum class State
+    {
+        idle,
+        settling,
+        capturing,
+        looping,
+        releasing
+    };
+
+    static int getLoopLength(double sampleRate);
+    static int getFadeLength(double sampleRate);
+
+    // Starts the crossfade back to the tank from the loop at loopPosition
+    void startRelease(int fadePosition);
+
+    float *loop[2] = {};
+    float *fadeIn = nullptr;
+    int loopLength = 0;
+    int fadeLength = 0;
+    int settleLength = 0;
+
+    State state = State::idle;
+    bool engaged = false;
+
+    // Samples settled or recorded so far, playback position, and release progress
+    int progress = 0;
+    int loopPosition = 0;
+    int releasePosition = 0;
+
+    // Longest recording made since prepare()
+    std::atomic<int> recordedLength{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FreezeLooper)
+};
@@ -0,0 +1,132 @@
+#include "LatencyDelay.h"
+
+int LatencyDelay::getHistoryLength(int maxDelay, int maxBlockSize)
+{
+    return juce::nextPowerOfTwo(maxDelay + maxBlockSize);
+}
+
+size_t LatencyDelay::getRequiredArenaSize(int maxDelay, int maxBlockSize)
+{
+    return 2 * DelayArena::paddedSize(getHistoryLength(maxDelay, maxBlockSize));
+}
+
+void LatencyDelay::prepare(double sampleRate, int maxDelay, int maxBlockSize, DelayArena &arena)
+{
+    const int historyLength = getHistoryLength(maxDelay, maxBlockSize);
+    historyMask = historyLength - 1;
+    history[0] = arena.carve(historyLength);
+    history[1] = arena.carve(historyLength);
+    maxDelaySamples = maxDelay;
+    historyPagedIn = false;
+
+    const double fadeTime = 0.02;
+    fadeInLength = juce::jmax(1, juce::roundToInt(sampleRate * fadeTime));
+    crossfade.reset(sampleRate, fadeTime);
+    reset();
+}
+
+void LatencyDelay::reset()
+{
+    // The history is cleared when recording next starts
+    recording = false;
+    currentDelay = nextDelay = requestedDelay;
+    crossfade.setCurrentAndTargetValue(0.0f);
+}
+
+void LatencyDelay::startRecording()
+{
+    for (auto *channel : history)
+        juce::FloatVectorOperations::clear(channel, historyMask + 1);
+
+    writeIndex = 0;
+    fadeInPosition = 0;
+    recording = true;
+    historyPagedIn = true;
+}
+
+void LatencyDelay::setDelay(int newDelay)
+{
+    requestedDelay = juce::jlimit(0, maxDelaySamples, newDelay);
+}
+
+size_t LatencyDelay::getTouchedArenaSize() const
+{
+    return historyPagedIn ? 2 * DelayArena::paddedSize(historyMask + 1) : 0;
+}
+
+int LatencyDelay::getAppliedDelay() const
+{
+    return crossfade.getCurrentValue() < 0.5f ? currentDelay : nextDelay;
+}
+
+void LatencyDelay::process(float *left, float *right, int numSamples) noexcept
+{
+    if (!recording)
+    {
+        // Settled on no delay with none requested: a plain pass-through
+        if (requestedDelay == 0 && currentDelay == 0)
+            return;
+
+        startRecording();
+    }
+
+    // Land a finished crossfade, then start the next one if one is waiting
+    if (!crossfade.isSmoothing())
+    {
+        currentDelay = nextDelay;
+
+        if (requestedDelay != currentDelay)
+        {
+            nextDelay = requestedDelay;
+            crossfade.setCurrentAndTargetValue(0.0f);
+            crossfade.setTargetValue(1.0f);
+        }
+    }
+
+    // Back on no delay with nothing pending: stop recording until the next request
+    if (currentDelay == 0 && !crossfade.isSmoothing())
+    {
+        recording = false;
+        return;
+    }
+
+    float *channels[2] = {left, right};
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const int firstRun = juce::jmin(numSamples, historyMask + 1 - writeIndex);
+        juce::FloatVectorOperations::copy(history[channel] + writeIndex, channels[channel], firstRun);
+        juce::FloatVectorOperations::copy(history[channel], channels[channel] + firstRun, numSamples - firstRun);
+    }
+
+    // Only signal from after recording started can reach a tap, so the
+    // first of it is ramped in; earlier taps read the cleared history
+    for (int i = 0; i < numSamples && fadeInPosition < fadeInLength; ++i, ++fadeInPosition)
+    {
+        const float gain = static_cast<float>(fadeInPosition) / static_cast<float>(fadeInLength);
+        const int index = (writeIndex + i) & historyMask;
+        history[0][index] *= gain;
+        history[1][index] *= gain;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float fade = crossfade.getNextValue();
+        const int fromIndex = (writeIndex + i - currentDelay) & historyMask;
+        const int toIndex = (writeIndex + i - nextDelay) & historyMask;
+
+        // A tap at no delay is the live input, which the history holds ramped.
+        // Both are read first since a mono pair aliases one buffer.
+        const float inputs[2] = {left[i], right[i]};
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const float input = inputs[channel];
+            const float from = currentDelay == 0 ? input : history[channel][fromIndex];
+            const float to = nextDelay == 0 ? input : history[channel][toIndex];
+            channels[channel][i] = from + fade * (to - from);
+        }
+    }
+
+    writeIndex = (writeIndex + numSamples) & historyMask;
+}
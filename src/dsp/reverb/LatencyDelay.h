@@ -0,0 +1,62 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayArena.h"
+
+// Stereo delay that keeps the dry path aligned with a wet path that has
+// lookahead. A change of delay crossfades between the old and new taps,
+// so the dry signal never jumps. The history is only recorded while a
+// delay is in use; at zero its pages are never touched.
+class LatencyDelay
+{
+public:
+    LatencyDelay() = default;
+    ~LatencyDelay() = default;
+
+    // Floats of arena space prepare() will carve
+    static size_t getRequiredArenaSize(int maxDelay, int maxBlockSize);
+
+    void prepare(double sampleRate, int maxDelay, int maxBlockSize, DelayArena &arena);
+    void reset();
+
+    // Audio thread only. A request made mid-crossfade waits for it to finish.
+    void setDelay(int newDelay);
+
+    // Delay the output will settle on
+    int getDelay() const { return requestedDelay; }
+
+    // Tap the output is mostly made of: the old one until a crossfade is
+    // half way through, then the new one
+    int getAppliedDelay() const;
+
+    void process(float *left, float *right, int numSamples) noexcept;
+
+    // Floats of history written since prepare(); the rest of the carve has
+    // never been paged in. Safe to call from any thread.
+    size_t getTouchedArenaSize() const;
+
+private:
+    static int getHistoryLength(int maxDelay, int maxBlockSize);
+
+    // Clears the history and starts writing it, ramping the input in so the
+    // delayed signal fades up rather than cutting in
+    void startRecording();
+
+    float *history[2] = {};
+    int historyMask = 0;
+    int writeIndex = 0;
+    int maxDelaySamples = 0;
+
+    bool recording = false;
+    std::atomic<bool> historyPagedIn{false};
+    int fadeInLength = 0;
+    int fadeInPosition = 0;
+
+    // Tap being faded from, tap being faded to, and the latest request
+    int currentDelay = 0;
+    int nextDelay = 0;
+    int requestedDelay = 0;
+    juce::LinearSmoothedValue<float> crossfade;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatencyDelay)
+};
@@ -0,0 +1,148 @@
+#include "LoopSaturator.h"
+
+namespace
+{
+    // Input gain at full drive (about +24dB)
+    constexpr float maxPreGain = 16.0f;
+
+    // Slope of the cubic at zero; the output is divided by it so quiet
+    // signals pass at unity and only peaks are squashed
+    constexpr float cubicSlope = 1.5f;
+}
+
+LoopSaturator::LoopSaturator()
+{
+    preGain.setCurrentAndTargetValue(1.0f);
+    engage.setCurrentAndTargetValue(0.0f);
+}
+
+size_t LoopSaturator::getRequiredArenaSize(int maxBlockSize)
+{
+    return DelayArena::paddedSize(2 * maxBlockSize) +
+           2 * DelayArena::paddedSize(maxOversampling * maxBlockSize) +
+           DelayArena::paddedSize(maxBlockSize);
+}
+
+void LoopSaturator::prepare(double sampleRate, int maxBlockSize, DelayArena &arena)
+{
+    maxBlock = maxBlockSize;
+    twiceRate = arena.carve(2 * maxBlockSize);
+    fourTimesRate = arena.carve(maxOversampling * maxBlockSize);
+    squares = arena.carve(maxOversampling * maxBlockSize);
+    dry = arena.carve(maxBlockSize);
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        interpolators[channel][0].prepare(maxBlockSize);
+        interpolators[channel][1].prepare(2 * maxBlockSize);
+        decimators[channel][0].prepare(2 * maxBlockSize);
+        decimators[channel][1].prepare(maxOversampling * maxBlockSize);
+    }
+
+    preGain.reset(sampleRate, 0.05);
+    engage.reset(sampleRate, 0.05);
+
+    reset();
+}
+
+void LoopSaturator::reset()
+{
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        for (int stage = 0; stage < 2; ++stage)
+        {
+            interpolators[channel][stage].reset();
+            decimators[channel][stage].reset();
+        }
+    }
+}
+
+void LoopSaturator::setDrive(float newDrive)
+{
+    const float drive = juce::jlimit(0.0f, 1.0f, newDrive);
+
+    // Equal steps in dB across the control's range
+    preGain.setTargetValue(std::pow(maxPreGain, drive));
+
+    // Waking from bypass starts the filters from silence
+    if (drive > 0.0f && !isActive())
+        reset();
+
+    engage.setTargetValue(drive > 0.0f ? 1.0f : 0.0f);
+}
+
+void LoopSaturator::setOversampling(int newFactor)
+{
+    const int newFactorClamped = newFactor >= maxOversampling ? maxOversampling : 2;
+
+    if (newFactorClamped != factor)
+    {
+        factor = newFactorClamped;
+        reset();
+    }
+}
+
+void LoopSaturator::shape(float *samples, int numSamples, float gain) noexcept
+{
+    // y = 1.5x - 0.5x^3 on the clipped input, which meets +/-1 with zero slope
+    juce::FloatVectorOperations::multiply(samples, gain, numSamples);
+    juce::FloatVectorOperations::clip(samples, samples, -1.0f, 1.0f, numSamples);
+    juce::FloatVectorOperations::multiply(squares, samples, samples, numSamples);
+    juce::FloatVectorOperations::multiply(squares, -0.5f / cubicSlope, numSamples);
+    juce::FloatVectorOperations::add(squares, 1.0f, numSamples);
+    juce::FloatVectorOperations::multiply(samples, squares, numSamples);
+
+    // Undo the input gain so the drive changes tone rather than loop level
+    juce::FloatVectorOperations::multiply(samples, 1.0f / gain, numSamples);
+}
+
+void LoopSaturator::process(float *left, float *right, int numSamples) noexcept
+{
+    jassert(numSamples <= maxBlock);
+
+    // One gain per call; calls are a sub-block long
+    const float gain = preGain.skip(numSamples);
+
+    // The engage fade as a linear ramp over this call, shared by both channels
+    const bool fading = engage.isSmoothing();
+    const float fadeStart = engage.getCurrentValue();
+    const float fadeStep = fading ? (engage.skip(numSamples) - fadeStart) / static_cast<float>(numSamples) : 0.0f;
+
+    float *channels[2] = {left, right};
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        float *samples = channels[channel];
+        auto &up = interpolators[channel];
+        auto &down = decimators[channel];
+
+        if (fading)
+            juce::FloatVectorOperations::copy(dry, samples, numSamples);
+
+        up[0].process(samples, numSamples, twiceRate, 2 * numSamples);
+
+        if (factor == maxOversampling)
+        {
+            up[1].process(twiceRate, 2 * numSamples, fourTimesRate, 4 * numSamples);
+            shape(fourTimesRate, 4 * numSamples, gain);
+            down[1].process(fourTimesRate, 4 * numSamples, twiceRate);
+        }
+        else
+        {
+            shape(twiceRate, 2 * numSamples, gain);
+        }
+
+        down[0].process(twiceRate, 2 * numSamples, samples);
+
+        // Crossfade against the unprocessed loop signal while engaging or bypassing
+        if (fading)
+        {
+            float fade = fadeStart;
+            for (int i = 0; i < numSamples; ++i)
+            {
+                fade += fadeStep;
+                samples[i] = dry[i] + fade * (samples[i] - dry[i]);
+            }
+        }
+    }
+}
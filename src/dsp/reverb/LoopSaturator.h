@@ -0,0 +1,54 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayArena.h"
+#include "HalfBandFilter.h"
+
+// Soft saturation for the signal recirculating through the tank loop.
+// The pair is oversampled 2x or 4x through cascaded polyphase half-bands,
+// shaped by a clipped cubic (vector ops only, no per-sample tanh) and
+// brought back down. It only ever sees the loop signal, so its filter
+// delay lengthens the loop rather than delaying the output.
+class LoopSaturator
+{
+public:
+    static constexpr int maxOversampling = 4;
+
+    LoopSaturator();
+    ~LoopSaturator() = default;
+
+    // Floats of arena space prepare() will carve
+    static size_t getRequiredArenaSize(int maxBlockSize);
+
+    void prepare(double sampleRate, int maxBlockSize, DelayArena &arena);
+    void reset();
+
+    void setDrive(float newDrive); // 0.0 - 1.0, 0 is bypassed
+
+    // 2 or 4; a change resets the filters, so make it from the audio thread
+    void setOversampling(int newFactor);
+
+    // True while the stage is engaged or fading out
+    bool isActive() const { return engage.getTargetValue() > 0.0f || engage.isSmoothing(); }
+
+    void process(float *left, float *right, int numSamples) noexcept;
+
+private:
+    // Shapes one channel at the oversampled rate
+    void shape(float *samples, int numSamples, float preGain) noexcept;
+
+    // Stage 0 is base rate <-> 2x, stage 1 is 2x <-> 4x
+    HalfBandInterpolator interpolators[2][2];
+    HalfBandDecimator decimators[2][2];
+
+    float *twiceRate = nullptr;
+    float *fourTimesRate = nullptr;
+    float *squares = nullptr;
+    float *dry = nullptr;
+    int maxBlock = 0;
+
+    int factor = 2;
+    juce::LinearSmoothedValue<float> preGain, engage;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoopSaturator)
+};
@@ -0,0 +1,150 @@
+#include "PitchShifter.h"
+
+namespace
+{
+    // Long enough to keep octave-down grains smooth, short enough not to smear
+    constexpr double grainSeconds = 0.06;
+}
+
+int PitchShifter::getGrainLength(double sampleRate)
+{
+    // Even, so the two grains sit exactly half a grain apart
+    return 2 * juce::roundToInt(grainSeconds * sampleRate * 0.5);
+}
+
+int PitchShifter::getHistoryLength(double sampleRate, int maxBlockSize)
+{
+    // A grain reads at most one grain length plus one block behind the
+    // write position, plus a sample for interpolation
+    return juce::nextPowerOfTwo(getGrainLength(sampleRate) + maxBlockSize + 4);
+}
+
+size_t PitchShifter::getRequiredArenaSize(double sampleRate, int maxBlockSize)
+{
+    return 2 * DelayArena::paddedSize(getHistoryLength(sampleRate, maxBlockSize)) +
+           DelayArena::paddedSize(getGrainLength(sampleRate)) +
+           2 * DelayArena::paddedSize(maxBlockSize);
+}
+
+void PitchShifter::prepare(double sampleRate, int maxBlockSize, DelayArena &arena)
+{
+    const int historyLength = getHistoryLength(sampleRate, maxBlockSize);
+    historyMask = historyLength - 1;
+    history[0] = arena.carve(historyLength);
+    history[1] = arena.carve(historyLength);
+
+    grainLength = getGrainLength(sampleRate);
+    window = arena.carve(grainLength);
+    for (int i = 0; i < grainLength; ++i)
+        window[i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * static_cast<float>(i) / static_cast<float>(grainLength));
+
+    maxBlock = maxBlockSize;
+    grainLeft = arena.carve(maxBlockSize);
+    grainRight = arena.carve(maxBlockSize);
+
+    reset();
+}
+
+void PitchShifter::reset()
+{
+    for (auto *channel : history)
+        if (channel != nullptr)
+            juce::FloatVectorOperations::clear(channel, historyMask + 1);
+
+    writeIndex = 0;
+
+    // Stagger the grains by half a grain
+    for (int g = 0; g < numGrains; ++g)
+    {
+        startGrain(grains[g], 0);
+        grains[g].age = g * grainLength / numGrains;
+        grains[g].position = std::fmod(grains[g].position + grains[g].increment * grains[g].age,
+                                       static_cast<double>(historyMask + 1));
+    }
+}
+
+void PitchShifter::setSemitones(float newSemitones)
+{
+    ratio = std::exp2(juce::jlimit(-maxSemitones, maxSemitones, newSemitones) / 12.0f);
+}
+
+void PitchShifter::startGrain(Grain &grain, int blockOffset) noexcept
+{
+    // Reads must stay a block plus an interpolation sample behind the
+    // newest history, so the starting delay covers that plus whatever an
+    // upward shift closes up over the grain
+    const double increment = ratio;
+    const double minDelay = maxBlock + 2.0;
+    const double startDelay = minDelay + juce::jmax(0.0, (increment - 1.0) * grainLength);
+
+    double position = writeIndex + blockOffset - startDelay;
+    const double historyLength = historyMask + 1;
+    while (position < 0.0)
+        position += historyLength;
+
+    grain.position = position;
+    grain.increment = increment;
+    grain.age = 0;
+}
+
+void PitchShifter::read(float *outLeft, float *outRight, int numSamples) noexcept
+{
+    jassert(numSamples <= maxBlock);
+
+    juce::FloatVectorOperations::clear(outLeft, numSamples);
+    juce::FloatVectorOperations::clear(outRight, numSamples);
+
+    const double historyLength = historyMask + 1;
+
+    for (auto &grain : grains)
+    {
+        int offset = 0;
+
+        while (offset < numSamples)
+        {
+            const int numThisTime = juce::jmin(numSamples - offset, grainLength - grain.age);
+
+            // Linearly interpolated reads at the shifted rate
+            double position = grain.position;
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                const int index = static_cast<int>(position);
+                const int next = (index + 1) & historyMask;
+                const float fraction = static_cast<float>(position - index);
+
+                grainLeft[i] = history[0][index] + fraction * (history[0][next] - history[0][index]);
+                grainRight[i] = history[1][index] + fraction * (history[1][next] - history[1][index]);
+
+                position += grain.increment;
+                if (position >= historyLength)
+                    position -= historyLength;
+            }
+
+            // The window slice for this run is contiguous, so mix in one pass
+            juce::FloatVectorOperations::addWithMultiply(outLeft + offset, grainLeft, window + grain.age, numThisTime);
+            juce::FloatVectorOperations::addWithMultiply(outRight + offset, grainRight, window + grain.age, numThisTime);
+
+            grain.position = position;
+            grain.age += numThisTime;
+            offset += numThisTime;
+
+            if (grain.age >= grainLength)
+                startGrain(grain, offset);
+        }
+    }
+}
+
+void PitchShifter::write(const float *left, const float *right, int numSamples) noexcept
+{
+    const float *inputs[2] = {left, right};
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        // At most two runs around the end of the ring
+        const int firstRun = juce::jmin(numSamples, historyMask + 1 - writeIndex);
+        juce::FloatVectorOperations::copy(history[channel] + writeIndex, inputs[channel], firstRun);
+        juce::FloatVectorOperations::copy(history[channel], inputs[channel] + firstRun, numSamples - firstRun);
+    }
+
+    writeIndex = (writeIndex + numSamples) & historyMask;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayArena.h"
+
+// Two-grain delay-line pitch shifter for the shimmer loop. Each grain reads
+// the history at the shifted rate under a Hann window; the grains are half
+// a grain apart so their windows sum to one. The window is a table one
+// grain long, so a grain's slice of it is contiguous and the grains are
+// mixed with vector multiply-adds. A new pitch takes effect as each grain
+// restarts, so changes never click.
+//
+// Reading and writing are separate so the shifted output of one block can
+// feed the tank before that block's tank output is written back.
+class PitchShifter
+{
+public:
+    static constexpr int numGrains = 2;
+    static constexpr float maxSemitones = 12.0f;
+
+    PitchShifter() = default;
+    ~PitchShifter() = default;
+
+    // Floats of arena space prepare() will carve
+    static size_t getRequiredArenaSize(double sampleRate, int maxBlockSize);
+
+    void prepare(double sampleRate, int maxBlockSize, DelayArena &arena);
+    void reset();
+
+    // -12 - +12 semitones
+    void setSemitones(float newSemitones);
+
+    // Writes numSamples of shifted output from the history written so far
+    void read(float *outLeft, float *outRight, int numSamples) noexcept;
+
+    // Appends numSamples to the history
+    void write(const float *left, const float *right, int numSamples) noexcept;
+
+private:
+    struct Grain
+    {
+        double position = 0.0;
+        double increment = 1.0;
+        int age = 0;
+    };
+
+    static int getGrainLength(double sampleRate);
+    static int getHistoryLength(double sampleRate, int maxBlockSize);
+
+    void startGrain(Grain &grain, int blockOffset) noexcept;
+
+    float *history[2] = {};
+    int historyMask = 0;
+    int writeIndex = 0;
+
+    // Hann window, one grain long
+    float *window = nullptr;
+    int grainLength = 0;
+
+    // One grain's interpolated reads for a block, before windowing
+    float *grainLeft = nullptr;
+    float *grainRight = nullptr;
+    int maxBlock = 0;
+
+    Grain grains[numGrains];
+    float ratio = 2.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PitchShifter)
+};
@@ -1,5 +1,20 @@
 #include "ReverbProcessor.h"
 
+namespace
+{
+    // Shimmer send at full amount, per unit of comb headroom (one minus the
+    // comb feedback). The tank's gain grows as its feedback nears one, so
+    // scaling by the headroom keeps the loop gain, and so the shimmer's
+    // sustain, about the same at every room size while staying below one.
+    constexpr float maxShimmerFeedback = 3.0f;
+
+    // Reverse window range; the dry path is delayed by the window in use.
+    // Lengths snap to steps so each one is a single latency change.
+    constexpr double minReverseSeconds = 0.1;
+    constexpr double maxReverseSeconds = 1.0;
+    constexpr double reverseStepSeconds = 0.05;
+}
+
 ReverbProcessor::ReverbProcessor()
     : roomSize(0.5f),
       damping(0.5f),
@@ -7,6 +22,29 @@ ReverbProcessor::ReverbProcessor()
       dryLevel(0.4f),
       width(1.0f),
       freezeMode(0.0f),
+      qualityMode(QualityMode::high),
+      captureFreeze(false),
+      halfRateTail(false),
+      lowCut(0.0f),
+      highCut(1.0f),
+      tilt(0.5f),
+      shimmerAmount(0.0f),
+      shimmerPitch(12.0f),
+      drive(0.0f),
+      driveOversampling(2),
+      tailMode(TailMode::normal),
+      reverseLength(0.4f),
+      gateThreshold(0.5f),
+      gateHold(0.3f),
+      duckAmount(0.0f),
+      duckThreshold(0.5f),
+      duckRelease(0.3f),
+      midSideMode(false),
+      sideRoomSize(0.5f),
+      sideDamping(0.5f),
+      midLevel(1.0f),
+      sideLevel(1.0f),
+      parametersChanged(false),
       currentSampleRate(44100.0),
       bufferSize(0)
 {
@@ -18,106 +56,541 @@ void ReverbProcessor::prepare(double sampleRate, int maxBlockSize)
     currentSampleRate = sampleRate;
     bufferSize = maxBlockSize;
 
-    // Initialize reverb with the current sample rate
-    reverb.setSampleRate(sampleRate);
+    // At half rate a sub-block (plus a carried sample) decimates to this many
+    const int maxLowRateSamples = subBlockSize / 2 + 1;
+    const int maxReverseWindow = getReverseWindowSamples(1.0f);
+
+    // Lay out the scratch buffers and every delay line in a single aligned
+    // block, sized for the full-rate tank since the half-rate one is smaller;
+    // nothing here depends on the host block size
+    optionalArenaSize = TailReverser::getRequiredArenaSize(maxReverseWindow, subBlockSize) +
+                        LatencyDelay::getRequiredArenaSize(maxReverseWindow, subBlockSize) +
+                        FreezeLooper::getRequiredArenaSize(sampleRate);
+
+    arena.allocate(4 * DelayArena::paddedSize(subBlockSize) +
+                   2 * DelayArena::paddedSize(maxLowRateSamples) +
+                   PitchShifter::getRequiredArenaSize(sampleRate, subBlockSize) +
+                   LoopSaturator::getRequiredArenaSize(subBlockSize) +
+                   WetGate::getRequiredArenaSize(subBlockSize) +
+                   WetDucker::getRequiredArenaSize(subBlockSize) +
+                   optionalArenaSize +
+                   ReverbTank::getRequiredArenaSize(sampleRate));
+
+    wetLeft = arena.carve(subBlockSize);
+    wetRight = arena.carve(subBlockSize);
+    lowLeft = arena.carve(maxLowRateSamples);
+    lowRight = arena.carve(maxLowRateSamples);
+    tankInputLeft = arena.carve(subBlockSize);
+    tankInputRight = arena.carve(subBlockSize);
+    shimmer.prepare(sampleRate, subBlockSize, arena);
+    saturator.prepare(sampleRate, subBlockSize, arena);
+    reverser.prepare(sampleRate, maxReverseWindow, subBlockSize, arena);
+    gate.prepare(sampleRate, subBlockSize, arena);
+    ducker.prepare(sampleRate, subBlockSize, arena);
+    dryDelay.prepare(sampleRate, maxReverseWindow, subBlockSize, arena);
+    freezeLooper.prepare(sampleRate, arena);
+    tankArenaMark = arena.getMark();
+
+    for (auto &decimator : decimators)
+        decimator.prepare(subBlockSize);
+    for (auto &interpolator : interpolators)
+        interpolator.prepare(maxLowRateSamples);
+
+    // Set the targets first so the smoother resets snap straight to them
+    parametersChanged = false;
     updateReverbSettings();
+
+    rebuildTank(halfRateTail);
+    toneFilter.prepare(sampleRate);
+
+    // Start in the requested tail mode with the dry delay already settled
+    activeTailMode = tailMode;
+    dryDelay.setDelay(getTargetDryDelay());
+    dryDelay.reset();
+    appliedLatency = dryDelay.getAppliedDelay();
+
+    const double smoothTime = 0.01;
+    dryGain.reset(sampleRate, smoothTime);
+    wetGain1.reset(sampleRate, smoothTime);
+    wetGain2.reset(sampleRate, smoothTime);
+
+    tankFade.reset(sampleRate, 0.02);
+    tankFade.setCurrentAndTargetValue(1.0f);
+
+    shimmerGain.reset(sampleRate, 0.05);
+    shimmerRunning = false;
+    subBlockPosition = 0;
 }
 
-void ReverbProcessor::processBlock(juce::AudioBuffer<float> &buffer)
+void ReverbProcessor::processBlock(juce::AudioBuffer<float> &buffer, const juce::AudioBuffer<float> *sidechain)
 {
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
     // Early return if we haven't been prepared yet
-    if (bufferSize == 0)
+    if (bufferSize == 0 || numChannels == 0)
         return;
 
-    // Create a buffer for the wet signal
-    juce::AudioBuffer<float> wetBuffer;
-    wetBuffer.makeCopyOf(buffer);
+    float *left = buffer.getWritePointer(0);
+    float *right = numChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+
+    // A mono sidechain keys both sides; without one the ducker follows the input
+    const float *sideLeft = nullptr;
+    const float *sideRight = nullptr;
+    if (sidechain != nullptr && sidechain->getNumChannels() > 0 && sidechain->getNumSamples() >= numSamples)
+    {
+        sideLeft = sidechain->getReadPointer(0);
+        sideRight = sidechain->getNumChannels() > 1 ? sidechain->getReadPointer(1) : sideLeft;
+    }
 
-    // Process the wet buffer with reverb
-    if (numChannels == 2)
+    // Process in fixed-size sub-blocks so the working set stays small. A
+    // host block ending mid sub-block leaves the rest for the next call, and
+    // parameter changes land only on the grid, independent of the host
+    // block size.
+    for (int offset = 0, numThisTime = 0; offset < numSamples; offset += numThisTime)
     {
-        // Process stereo
-        reverb.processStereo(wetBuffer.getWritePointer(0),
-                             wetBuffer.getWritePointer(1),
-                             numSamples);
+        numThisTime = juce::jmin(subBlockSize - subBlockPosition, numSamples - offset);
+
+        if (subBlockPosition == 0)
+        {
+            tank.setQualityTier(renderTier);
+            applyPendingParameters();
+            updateWetPathSwitches();
+        }
+
+        subBlockPosition = (subBlockPosition + numThisTime) % subBlockSize;
+
+        float *inLeft = left + offset;
+        float *inRight = right != nullptr ? right + offset : nullptr;
+
+        // Mono input feeds both sides of the tank
+        const float *tankLeft = inLeft;
+        const float *tankRight = inRight != nullptr ? inRight : inLeft;
+
+        const float *keyLeft = sideLeft != nullptr ? sideLeft + offset : tankLeft;
+        const float *keyRight = sideRight != nullptr ? sideRight + offset : tankRight;
+
+        // A frozen tank takes no input, so while its captured loop plays
+        // neither it nor the shimmer feeding it needs to run
+        if (freezeLooper.isLooping())
+        {
+            tankSleeping = true;
+        }
+        else
+        {
+            // Shimmer history from before the sleep no longer matches the tank
+            if (tankSleeping)
+            {
+                shimmer.reset();
+                tankSleeping = false;
+            }
+
+            if (updateShimmer())
+            {
+                mixShimmer(tankLeft, tankRight, numThisTime);
+                tankLeft = tankInputLeft;
+                tankRight = tankInputRight;
+            }
+
+            processTank(tankLeft, tankRight, numThisTime);
+
+            if (shimmerRunning)
+                shimmer.write(wetLeft, wetRight, numThisTime);
+        }
+
+        freezeLooper.process(wetLeft, wetRight, numThisTime);
+
+        toneFilter.process(wetLeft, wetRight, numThisTime);
+
+        if (activeTailMode == TailMode::reverse)
+            reverser.process(wetLeft, wetRight, numThisTime);
+        else if (activeTailMode == TailMode::gated)
+            gate.process(inLeft, inRight != nullptr ? inRight : inLeft, wetLeft, wetRight, numThisTime);
+
+        ducker.process(keyLeft, keyRight, wetLeft, wetRight, numThisTime);
+
+        // Keeps the dry signal in line with a reversed tail
+        dryDelay.setDelay(getTargetDryDelay());
+        dryDelay.process(inLeft, inRight != nullptr ? inRight : inLeft, numThisTime);
+        appliedLatency = dryDelay.getAppliedDelay();
+
+        for (int i = 0; i < numThisTime; ++i)
+        {
+            const float fade = tankFade.getNextValue();
+            const float dry = dryGain.getNextValue();
+            const float wet1 = wetGain1.getNextValue() * fade;
+            const float wet2 = wetGain2.getNextValue() * fade;
+
+            inLeft[i] = wetLeft[i] * wet1 + wetRight[i] * wet2 + inLeft[i] * dry;
+
+            if (inRight != nullptr)
+                inRight[i] = wetRight[i] * wet1 + wetLeft[i] * wet2 + inRight[i] * dry;
+        }
     }
-    else if (numChannels == 1)
+}
+
+void ReverbProcessor::processTank(const float *inLeft, const float *inRight, int numSamples)
+{
+    if (!tankIsHalfRate)
     {
-        // Create a temporary buffer for the second channel in mono case
-        juce::AudioBuffer<float> tempStereo(2, numSamples);
-        tempStereo.copyFrom(0, 0, wetBuffer, 0, 0, numSamples);
-        tempStereo.copyFrom(1, 0, wetBuffer, 0, 0, numSamples);
-
-        // Process as stereo
-        reverb.processStereo(tempStereo.getWritePointer(0),
-                             tempStereo.getWritePointer(1),
-                             numSamples);
-
-        // Copy back the first channel to our wet buffer
-        wetBuffer.copyFrom(0, 0, tempStereo, 0, 0, numSamples);
+        tank.process(inLeft, inRight, wetLeft, wetRight, numSamples);
+        return;
     }
 
-    // Since the JUCE Reverb processor already applies wet/dry internally,
-    // we don't need to manually mix here. Just copy the processed buffer back.
-    buffer.makeCopyOf(wetBuffer);
+    // Decimate, run the tank at half rate in place, then interpolate back.
+    // The filters add about 31 samples of pre-delay to the wet path only.
+    const int numLowRate = decimators[0].process(inLeft, numSamples, lowLeft);
+    decimators[1].process(inRight, numSamples, lowRight);
+
+    tank.process(lowLeft, lowRight, lowLeft, lowRight, numLowRate);
+
+    interpolators[0].process(lowLeft, numLowRate, wetLeft, numSamples);
+    interpolators[1].process(lowRight, numLowRate, wetRight, numSamples);
+}
+
+bool ReverbProcessor::updateShimmer()
+{
+    const bool wantShimmer = shimmerGain.getTargetValue() > 0.0f || shimmerGain.isSmoothing();
+
+    // History left over from the last time it ran is stale
+    if (wantShimmer && !shimmerRunning)
+        shimmer.reset();
+
+    shimmerRunning = wantShimmer;
+    return shimmerRunning;
+}
+
+void ReverbProcessor::mixShimmer(const float *inLeft, const float *inRight, int numSamples)
+{
+    // The tail shifted from earlier sub-blocks joins this one's input
+    shimmer.read(tankInputLeft, tankInputRight, numSamples);
+
+    // Only the recirculating signal is driven, never the input or the wet path
+    if (saturator.isActive())
+        saturator.process(tankInputLeft, tankInputRight, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float gain = shimmerGain.getNextValue();
+        tankInputLeft[i] = inLeft[i] + tankInputLeft[i] * gain;
+        tankInputRight[i] = inRight[i] + tankInputRight[i] * gain;
+    }
+}
+
+void ReverbProcessor::updateWetPathSwitches()
+{
+    const bool wantHalfRate = halfRateTail.load();
+    const bool wantMidSide = midSideMode.load();
+    const TailMode wantTailMode = tailMode.load();
+
+    if (wantHalfRate == tankIsHalfRate && wantMidSide == tank.isMidSide() && wantTailMode == activeTailMode)
+    {
+        // Either nothing pending or the switch was undone mid-fade
+        if (tankFade.getTargetValue() < 1.0f)
+            tankFade.setTargetValue(1.0f);
+        return;
+    }
+
+    // Fade the wet path out, make the switch once silent, then fade back in
+    if (tankFade.getTargetValue() > 0.0f)
+    {
+        tankFade.setTargetValue(0.0f);
+    }
+    else if (!tankFade.isSmoothing())
+    {
+        if (wantHalfRate != tankIsHalfRate)
+            rebuildTank(wantHalfRate);
+
+        if (wantMidSide != tank.isMidSide())
+        {
+            tank.setMidSide(wantMidSide);
+            freezeLooper.reset();
+        }
+
+        if (wantTailMode != activeTailMode)
+        {
+            // Only state is reset here; every buffer was laid out in prepare()
+            reverser.reset();
+            gate.reset();
+            activeTailMode = wantTailMode;
+        }
+
+        tankFade.setTargetValue(1.0f);
+    }
+}
+
+int ReverbProcessor::getReverseWindowSamples(float length) const
+{
+    const double range = maxReverseSeconds - minReverseSeconds;
+    const double steps = std::round(length * range / reverseStepSeconds);
+    const double seconds = minReverseSeconds + steps * reverseStepSeconds;
+    return juce::roundToInt(seconds * currentSampleRate * 0.5) * 2;
+}
+
+void ReverbProcessor::rebuildTank(bool halfRate)
+{
+    arena.rewind(tankArenaMark);
+    tank.prepare(halfRate ? currentSampleRate * 0.5 : currentSampleRate, arena);
+
+    for (auto &decimator : decimators)
+        decimator.reset();
+    for (auto &interpolator : interpolators)
+        interpolator.reset();
+    toneFilter.reset();
+
+    // A loop of the old tank would hand back to an empty one
+    freezeLooper.reset();
+
+    tankIsHalfRate = halfRate;
 }
 
 void ReverbProcessor::reset()
 {
-    reverb.reset();
+    tank.reset();
+    toneFilter.reset();
+    shimmer.reset();
+    saturator.reset();
+    reverser.reset();
+    gate.reset();
+    ducker.reset();
+    dryDelay.reset();
+    freezeLooper.reset();
+    subBlockPosition = 0;
+
+    for (auto &decimator : decimators)
+        decimator.reset();
+    for (auto &interpolator : interpolators)
+        interpolator.reset();
 }
 
 void ReverbProcessor::updateReverbSettings()
 {
-    juce::Reverb::Parameters params;
-    params.roomSize = roomSize;
-    params.damping = damping;
-    params.wetLevel = wetLevel;
-    params.dryLevel = dryLevel;
-    params.width = width;
-    params.freezeMode = freezeMode;
+    // Same scaling as juce::Reverb so existing sessions sound unchanged
+    const float wetScaleFactor = 3.0f;
+    const float dryScaleFactor = 2.0f;
+
+    const float wet = wetLevel.load() * wetScaleFactor;
+    const float currentWidth = width.load();
+
+    dryGain.setTargetValue(dryLevel.load() * dryScaleFactor);
+    wetGain1.setTargetValue(0.5f * wet * (1.0f + currentWidth));
+    wetGain2.setTargetValue(0.5f * wet * (1.0f - currentWidth));
+
+    tank.setParameters(roomSize.load(), damping.load(), freezeMode.load() >= 0.5f);
+    tank.setSideParameters(sideRoomSize.load(), sideDamping.load());
+    tank.setMidSideLevels(midLevel.load(), sideLevel.load());
+    freezeLooper.setEngaged(captureFreeze.load() && freezeMode.load() >= 0.5f);
+    toneFilter.setParameters(lowCut.load(), highCut.load(), tilt.load());
+
+    // In mid/side mode the longer of the two tanks sets the loop gain
+    const float loopRoomSize = midSideMode.load() ? juce::jmax(roomSize.load(), sideRoomSize.load()) : roomSize.load();
+    const float combHeadroom = 1.0f - ReverbTank::getCombFeedback(loopRoomSize);
+    shimmerGain.setTargetValue(shimmerAmount.load() * maxShimmerFeedback * combHeadroom);
+    shimmer.setSemitones(shimmerPitch.load());
+
+    saturator.setOversampling(driveOversampling.load());
+    saturator.setDrive(drive.load());
+
+    reverser.setWindowLength(getReverseWindowSamples(reverseLength.load()));
+    gate.setThreshold(gateThreshold.load());
+    gate.setHold(gateHold.load());
 
-    reverb.setParameters(params);
+    ducker.setAmount(duckAmount.load());
+    ducker.setThreshold(duckThreshold.load());
+    ducker.setRelease(duckRelease.load());
+}
+
+void ReverbProcessor::applyPendingParameters()
+{
+    if (parametersChanged.exchange(false))
+        updateReverbSettings();
 }
 
 // Parameter setters
 void ReverbProcessor::setRoomSize(float newRoomSize)
 {
     roomSize = juce::jlimit(0.0f, 1.0f, newRoomSize);
-    updateReverbSettings();
+    parametersChanged = true;
 }
 
 void ReverbProcessor::setDamping(float newDamping)
 {
     damping = juce::jlimit(0.0f, 1.0f, newDamping);
-    updateReverbSettings();
+    parametersChanged = true;
 }
 
 void ReverbProcessor::setWetLevel(float newWetLevel)
 {
     wetLevel = juce::jlimit(0.0f, 1.0f, newWetLevel);
-    updateReverbSettings();
+    parametersChanged = true;
 }
 
 void ReverbProcessor::setDryLevel(float newDryLevel)
 {
     dryLevel = juce::jlimit(0.0f, 1.0f, newDryLevel);
-    updateReverbSettings();
+    parametersChanged = true;
 }
 
 void ReverbProcessor::setWidth(float newWidth)
 {
     width = juce::jlimit(0.0f, 1.0f, newWidth);
-    updateReverbSettings();
+    parametersChanged = true;
 }
 
 void ReverbProcessor::setFreezeMode(float newFreezeMode)
 {
     freezeMode = juce::jlimit(0.0f, 1.0f, newFreezeMode);
-    updateReverbSettings();
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setQualityMode(QualityMode newMode)
+{
+    qualityMode = newMode;
+}
+
+void ReverbProcessor::setCaptureFreeze(bool shouldCapture)
+{
+    captureFreeze = shouldCapture;
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setLowCut(float newLowCut)
+{
+    lowCut = juce::jlimit(0.0f, 1.0f, newLowCut);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setHighCut(float newHighCut)
+{
+    highCut = juce::jlimit(0.0f, 1.0f, newHighCut);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setTilt(float newTilt)
+{
+    tilt = juce::jlimit(0.0f, 1.0f, newTilt);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setShimmerAmount(float newAmount)
+{
+    shimmerAmount = juce::jlimit(0.0f, 1.0f, newAmount);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setShimmerPitch(float newSemitones)
+{
+    shimmerPitch = juce::jlimit(-PitchShifter::maxSemitones, PitchShifter::maxSemitones, newSemitones);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setDrive(float newDrive)
+{
+    drive = juce::jlimit(0.0f, 1.0f, newDrive);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setDriveOversampling(int newFactor)
+{
+    driveOversampling = newFactor >= LoopSaturator::maxOversampling ? LoopSaturator::maxOversampling : 2;
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setTailMode(TailMode newMode)
+{
+    tailMode = newMode;
+}
+
+void ReverbProcessor::setReverseLength(float newLength)
+{
+    reverseLength = juce::jlimit(0.0f, 1.0f, newLength);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setGateThreshold(float newThreshold)
+{
+    gateThreshold = juce::jlimit(0.0f, 1.0f, newThreshold);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setGateHold(float newHold)
+{
+    gateHold = juce::jlimit(0.0f, 1.0f, newHold);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setDuckAmount(float newAmount)
+{
+    duckAmount = juce::jlimit(0.0f, 1.0f, newAmount);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setDuckThreshold(float newThreshold)
+{
+    duckThreshold = juce::jlimit(0.0f, 1.0f, newThreshold);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setDuckRelease(float newRelease)
+{
+    duckRelease = juce::jlimit(0.0f, 1.0f, newRelease);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setMidSideMode(bool shouldUseMidSide)
+{
+    // The switch itself waits for the wet fade; the shimmer headroom follows now
+    midSideMode = shouldUseMidSide;
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setSideRoomSize(float newRoomSize)
+{
+    sideRoomSize = juce::jlimit(0.0f, 1.0f, newRoomSize);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setSideDamping(float newDamping)
+{
+    sideDamping = juce::jlimit(0.0f, 1.0f, newDamping);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setMidLevel(float newLevel)
+{
+    midLevel = juce::jlimit(0.0f, 1.0f, newLevel);
+    parametersChanged = true;
+}
+
+void ReverbProcessor::setSideLevel(float newLevel)
+{
+    sideLevel = juce::jlimit(0.0f, 1.0f, newLevel);
+    parametersChanged = true;
+}
+
+int ReverbProcessor::getLatencySamples() const
+{
+    return appliedLatency.load();
+}
+
+int ReverbProcessor::getTargetDryDelay() const
+{
+    // Only the reverse window delays the output. The saturator's
+    // oversampling filters sit in the shimmer loop, so they lengthen it.
+    if (activeTailMode == TailMode::reverse)
+        return getReverseWindowSamples(reverseLength.load());
+
+    return 0;
+}
+
+void ReverbProcessor::setHalfRateTail(bool shouldUseHalfRate)
+{
+    halfRateTail = shouldUseHalfRate;
+}
+
+void ReverbProcessor::setRenderTier(ReverbTank::QualityTier tier)
+{
+    renderTier = tier;
 }
 
 // Parameter getters
@@ -149,4 +622,124 @@ float ReverbProcessor::getWidth() const
 float ReverbProcessor::getFreezeMode() const
 {
     return freezeMode;
+}
+
+ReverbProcessor::QualityMode ReverbProcessor::getQualityMode() const
+{
+    return qualityMode;
+}
+
+bool ReverbProcessor::getCaptureFreeze() const
+{
+    return captureFreeze;
+}
+
+float ReverbProcessor::getLowCut() const
+{
+    return lowCut;
+}
+
+float ReverbProcessor::getHighCut() const
+{
+    return highCut;
+}
+
+float ReverbProcessor::getTilt() const
+{
+    return tilt;
+}
+
+float ReverbProcessor::getShimmerAmount() const
+{
+    return shimmerAmount;
+}
+
+float ReverbProcessor::getShimmerPitch() const
+{
+    return shimmerPitch;
+}
+
+float ReverbProcessor::getDrive() const
+{
+    return drive;
+}
+
+int ReverbProcessor::getDriveOversampling() const
+{
+    return driveOversampling;
+}
+
+ReverbProcessor::TailMode ReverbProcessor::getTailMode() const
+{
+    return tailMode;
+}
+
+float ReverbProcessor::getReverseLength() const
+{
+    return reverseLength;
+}
+
+float ReverbProcessor::getGateThreshold() const
+{
+    return gateThreshold;
+}
+
+float ReverbProcessor::getGateHold() const
+{
+    return gateHold;
+}
+
+float ReverbProcessor::getDuckAmount() const
+{
+    return duckAmount;
+}
+
+float ReverbProcessor::getDuckThreshold() const
+{
+    return duckThreshold;
+}
+
+float ReverbProcessor::getDuckRelease() const
+{
+    return duckRelease;
+}
+
+bool ReverbProcessor::getMidSideMode() const
+{
+    return midSideMode;
+}
+
+float ReverbProcessor::getSideRoomSize() const
+{
+    return sideRoomSize;
+}
+
+float ReverbProcessor::getSideDamping() const
+{
+    return sideDamping;
+}
+
+float ReverbProcessor::getMidLevel() const
+{
+    return midLevel;
+}
+
+float ReverbProcessor::getSideLevel() const
+{
+    return sideLevel;
+}
+
+bool ReverbProcessor::getHalfRateTail() const
+{
+    return halfRateTail;
+}
+
+ReverbProcessor::MemoryFootprint ReverbProcessor::getMemoryFootprint() const
+{
+    MemoryFootprint footprint;
+    footprint.optionalBytes = optionalArenaSize * sizeof(float);
+    footprint.optionalResidentBytes = (reverser.getTouchedArenaSize() + dryDelay.getTouchedArenaSize() +
+                                       freezeLooper.getTouchedArenaSize()) * sizeof(float);
+    footprint.coreBytes = sizeof(ReverbProcessor) + arena.getSizeInBytes() - footprint.optionalBytes;
+    return footprint;
 }
\ No newline at end of file
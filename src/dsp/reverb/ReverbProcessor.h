@@ -1,6 +1,17 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "DelayArena.h"
+#include "FreezeLooper.h"
+#include "HalfBandFilter.h"
+#include "LatencyDelay.h"
+#include "LoopSaturator.h"
+#include "PitchShifter.h"
+#include "ReverbTank.h"
+#include "TailReverser.h"
+#include "WetDucker.h"
+#include "WetGate.h"
+#include "WetToneFilter.h"
 
 class ReverbProcessor
 {
@@ -9,11 +20,37 @@ public:
     ~ReverbProcessor() = default;
 
     void prepare(double sampleRate, int maxBlockSize);
-    void processBlock(juce::AudioBuffer<float> &buffer);
     void reset();
 
+    // The sidechain, when given, keys the ducker in place of the dry input
+    void processBlock(juce::AudioBuffer<float> &buffer, const juce::AudioBuffer<float> *sidechain = nullptr);
+
     void updateReverbSettings();
 
+    // User-facing quality setting; automatic lets the plugin pick the tier
+    enum class QualityMode
+    {
+        eco,
+        normal,
+        high,
+        automatic
+    };
+
+    // What happens to the tail after the tank. Reverse plays it backwards
+    // in windows and delays the dry path to match; gated cuts it off once
+    // the input falls below a threshold.
+    enum class TailMode
+    {
+        normal,
+        reverse,
+        gated
+    };
+
+    // Size of the internal processing chunks. Sub-blocks follow a fixed grid
+    // in the sample stream, so host blocks of any length are split at the
+    // same positions and the output doesn't depend on the host block size.
+    static constexpr int subBlockSize = 64;
+
     // Parameter setters
     void setRoomSize(float newRoomSize);     // 0.0 - 1.0
     void setDamping(float newDamping);       // 0.0 - 1.0
@@ -21,6 +58,59 @@ public:
     void setDryLevel(float newDryLevel);     // 0.0 - 1.0
     void setWidth(float newWidth);           // 0.0 - 1.0
     void setFreezeMode(float newFreezeMode); // 0.0 - 1.0
+    void setQualityMode(QualityMode newMode);
+
+    // Freeze by recording a loop of the tank and letting it sleep, instead
+    // of recirculating it; unfreezing crossfades back to the live tank
+    void setCaptureFreeze(bool shouldCapture);
+
+    // Wet-path tone after the tank; see WetToneFilter for the mapping
+    void setLowCut(float newLowCut);   // 0.0 - 1.0, 0 is off
+    void setHighCut(float newHighCut); // 0.0 - 1.0, 1 is off
+    void setTilt(float newTilt);       // 0.0 - 1.0, 0.5 is flat
+
+    // Shimmer: the tail is pitch shifted and fed back into the tank input
+    void setShimmerAmount(float newAmount);   // 0.0 - 1.0, 0 is off
+    void setShimmerPitch(float newSemitones); // -12 - +12 semitones
+
+    // Saturation of the shimmer loop signal. Only acts while the loop runs;
+    // a pitch of 0 gives plain driven regeneration.
+    void setDrive(float newDrive);            // 0.0 - 1.0, 0 is off
+    void setDriveOversampling(int newFactor); // 2 or 4
+
+    // Mode switches fade the wet path out and back in around the change
+    void setTailMode(TailMode newMode);
+    void setReverseLength(float newLength); // 0.0 - 1.0, 100ms - 1s
+    void setGateThreshold(float newThreshold); // 0.0 - 1.0, -60dB - 0dB
+    void setGateHold(float newHold);           // 0.0 - 1.0, 50ms - 1s
+
+    // Ducks the wet output under the sidechain, or the dry input without one
+    void setDuckAmount(float newAmount);       // 0.0 - 1.0, 0dB - 30dB, 0 is off
+    void setDuckThreshold(float newThreshold); // 0.0 - 1.0, -60dB - 0dB
+    void setDuckRelease(float newRelease);     // 0.0 - 1.0, 50ms - 2s
+
+    // Mid/side mode runs separate mid and side tanks inside the one tank
+    // pass. Room size and damping tune the mid tank; the width setting
+    // still applies to the decoded pair. Switching fades the wet path.
+    void setMidSideMode(bool shouldUseMidSide);
+    void setSideRoomSize(float newRoomSize); // 0.0 - 1.0
+    void setSideDamping(float newDamping);   // 0.0 - 1.0
+    void setMidLevel(float newLevel);        // 0.0 - 1.0, linear gain
+    void setSideLevel(float newLevel);       // 0.0 - 1.0, linear gain
+
+    // Samples the output lags the input by, for the host's delay compensation.
+    // Follows the dry delay actually applied, so it changes half way through
+    // the dry crossfade rather than when a switch is requested.
+    int getLatencySamples() const;
+
+    // Runs the tank at half the sample rate; the dry path stays at full rate.
+    // Switching fades the wet signal out and back in around the change.
+    void setHalfRateTail(bool shouldUseHalfRate);
+
+    // Tier actually rendered, chosen by the plugin before each block.
+    // Audio thread only; takes effect on the sub-block grid and crossfades
+    // inside the tank.
+    void setRenderTier(ReverbTank::QualityTier tier);
 
     // Parameter getters
     float getRoomSize() const;
@@ -29,22 +119,168 @@ public:
     float getDryLevel() const;
     float getWidth() const;
     float getFreezeMode() const;
+    QualityMode getQualityMode() const;
+    bool getCaptureFreeze() const;
+    float getLowCut() const;
+    float getHighCut() const;
+    float getTilt() const;
+    float getShimmerAmount() const;
+    float getShimmerPitch() const;
+    float getDrive() const;
+    int getDriveOversampling() const;
+    TailMode getTailMode() const;
+    float getReverseLength() const;
+    float getGateThreshold() const;
+    float getGateHold() const;
+    float getDuckAmount() const;
+    float getDuckThreshold() const;
+    float getDuckRelease() const;
+    bool getMidSideMode() const;
+    float getSideRoomSize() const;
+    float getSideDamping() const;
+    float getMidLevel() const;
+    float getSideLevel() const;
+    bool getHalfRateTail() const;
+
+    // Approximate heap and object bytes held by a processor, for footprint
+    // reporting. The buffers only an optional mode uses (the reverse history,
+    // the dry delay and the capture freeze loop) are carved for every
+    // instance but left untouched, so they only become resident once that
+    // mode first runs.
+    struct MemoryFootprint
+    {
+        size_t coreBytes = 0;             // object, scratch, shimmer and tank lines
+        size_t optionalBytes = 0;         // optional-mode buffers, as reserved
+        size_t optionalResidentBytes = 0; // the part of those written so far
+
+        size_t getResidentBytes() const { return coreBytes + optionalResidentBytes; }
+        size_t getReservedBytes() const { return coreBytes + optionalBytes; }
+    };
+
+    MemoryFootprint getMemoryFootprint() const;
 
 private:
-    // Reverb parameters
-    float roomSize;
-    float damping;
-    float wetLevel;
-    float dryLevel;
-    float width;
-    float freezeMode;
+    // Applies parameter changes made since the last sub-block
+    void applyPendingParameters();
+
+    // Starts or completes a pending full/half-rate, mid/side or tail mode switch
+    void updateWetPathSwitches();
+
+    // Reverse window at the current sample rate for a normalised length,
+    // in coarse steps so sweeping the length rarely changes the latency
+    int getReverseWindowSamples(float length) const;
+
+    // Dry delay matching the applied tail mode
+    int getTargetDryDelay() const;
+
+    // Re-lays out the tank in the arena for the given rate; no allocation
+    void rebuildTank(bool halfRate);
+
+    // Runs the tank on one sub-block, leaving the wet pair in wetLeft/wetRight
+    void processTank(const float *inLeft, const float *inRight, int numSamples);
+
+    // Starts or stops the shimmer loop; returns true while it should run
+    bool updateShimmer();
+
+    // Adds the shifted (and driven) tail to the input, leaving the tank input in tankInputLeft/Right
+    void mixShimmer(const float *inLeft, const float *inRight, int numSamples);
+
+    // Reverb parameters (written from the message thread, read on the audio thread)
+    std::atomic<float> roomSize;
+    std::atomic<float> damping;
+    std::atomic<float> wetLevel;
+    std::atomic<float> dryLevel;
+    std::atomic<float> width;
+    std::atomic<float> freezeMode;
+    std::atomic<QualityMode> qualityMode;
+    std::atomic<bool> captureFreeze;
+    std::atomic<bool> halfRateTail;
+    std::atomic<float> lowCut;
+    std::atomic<float> highCut;
+    std::atomic<float> tilt;
+    std::atomic<float> shimmerAmount;
+    std::atomic<float> shimmerPitch;
+    std::atomic<float> drive;
+    std::atomic<int> driveOversampling;
+    std::atomic<TailMode> tailMode;
+    std::atomic<float> reverseLength;
+    std::atomic<float> gateThreshold;
+    std::atomic<float> gateHold;
+    std::atomic<float> duckAmount;
+    std::atomic<float> duckThreshold;
+    std::atomic<float> duckRelease;
+    std::atomic<bool> midSideMode;
+    std::atomic<float> sideRoomSize;
+    std::atomic<float> sideDamping;
+    std::atomic<float> midLevel;
+    std::atomic<float> sideLevel;
+    std::atomic<bool> parametersChanged;
 
     // Internal state
     double currentSampleRate;
     int bufferSize;
 
-    // JUCE Reverb processor
-    juce::Reverb reverb;
+    // Samples already processed of the current grid sub-block
+    int subBlockPosition = 0;
+
+    // Last tier passed to setRenderTier(), handed to the tank on the grid
+    ReverbTank::QualityTier renderTier = ReverbTank::QualityTier::high;
+
+    // Single allocation backing the tank's delay lines and the scratch buffers
+    DelayArena arena;
+    ReverbTank tank;
+
+    // Wet output of the tank for one sub-block, carved from the arena
+    float *wetLeft = nullptr;
+    float *wetRight = nullptr;
+
+    // Half-rate tail: decimated input and tank output for one sub-block
+    HalfBandDecimator decimators[2];
+    HalfBandInterpolator interpolators[2];
+    float *lowLeft = nullptr;
+    float *lowRight = nullptr;
+    bool tankIsHalfRate = false;
+
+    // Capture freeze; the tank is skipped while the loop plays
+    FreezeLooper freezeLooper;
+    bool tankSleeping = false;
+
+    // Shimmer loop: shifter history plus the tank input it mixes into
+    PitchShifter shimmer;
+    LoopSaturator saturator;
+    float *tankInputLeft = nullptr;
+    float *tankInputRight = nullptr;
+    juce::LinearSmoothedValue<float> shimmerGain;
+    bool shimmerRunning = false;
+
+    // Tail modes. The reverser's history and the dry delay are sized for
+    // the longest window in prepare(), so switching never allocates
+    TailMode activeTailMode = TailMode::normal;
+    TailReverser reverser;
+    WetGate gate;
+    LatencyDelay dryDelay;
+
+    // Dry delay in effect at the end of the last sub-block, read by the host
+    // from any thread
+    std::atomic<int> appliedLatency{0};
+
+    // Sidechain-keyed ducking of the wet pair
+    WetDucker ducker;
+
+    // Arena position where the tank's delay lines start
+    size_t tankArenaMark = 0;
+
+    // Floats of the arena carved for the optional-mode buffers
+    size_t optionalArenaSize = 0;
+
+    // Low cut, high cut and tilt on the wet pair
+    WetToneFilter toneFilter;
+
+    // Wet fade used to hide tank rebuilds and mode switches
+    juce::LinearSmoothedValue<float> tankFade;
+
+    // Output mix gains, smoothed like juce::Reverb's
+    juce::LinearSmoothedValue<float> dryGain, wetGain1, wetGain2;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReverbProcessor)
 };
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "ReverbTank.h"
+
+namespace
+{
+    // Freeverb tunings at 44.1kHz, shared by every instance
+    constexpr short combTunings[ReverbTank::numCombs] = {1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617};
+    constexpr short allPassTunings[ReverbTank::numAllPasses] = {556, 441, 341, 225};
+    constexpr int stereoSpread = 23;
+}
+
+ReverbTank::ReverbTank()
+{
+    // Start with every stage fully in, i.e. the high tier
+    for (auto &gain : combGains)
+        gain.setCurrentAndTargetValue(1.0f);
+    for (auto &mix : allPassMixes)
+        mix.setCurrentAndTargetValue(1.0f);
+
+    midLevel.setCurrentAndTargetValue(1.0f);
+    sideLevel.setCurrentAndTargetValue(1.0f);
+}
+
+int ReverbTank::getCombLength(int channel, int comb, double sampleRate)
+{
+    const int intSampleRate = static_cast<int>(sampleRate);
+    return (intSampleRate * (combTunings[comb] + channel * stereoSpread)) / 44100;
+}
+
+int ReverbTank::getAllPassLength(int channel, int allPass, double sampleRate)
+{
+    const int intSampleRate = static_cast<int>(sampleRate);
+    return (intSampleRate * (allPassTunings[allPass] + channel * stereoSpread)) / 44100;
+}
+
+size_t ReverbTank::getRequiredArenaSize(double sampleRate)
+{
+    size_t total = 0;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        for (int i = 0; i < numCombs; ++i)
+            total += DelayArena::paddedSize(getCombLength(channel, i, sampleRate));
+
+        for (int i = 0; i < numAllPasses; ++i)
+            total += DelayArena::paddedSize(getAllPassLength(channel, i, sampleRate));
+    }
+
+    return total;
+}
+
+void ReverbTank::prepare(double sampleRate, DelayArena &arena)
+{
+    // Carve in processing order so each step walks forward through the arena
+    for (int i = 0; i < numCombs; ++i)
+    {
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            combBank.sizes[channel][i] = getCombLength(channel, i, sampleRate);
+            combBank.buffers[channel][i] = arena.carve(combBank.sizes[channel][i]);
+        }
+    }
+
+    for (int i = 0; i < numAllPasses; ++i)
+    {
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            auto &allPass = allPasses[channel][i];
+            allPass.size = getAllPassLength(channel, i, sampleRate);
+            allPass.buffer = arena.carve(allPass.size);
+        }
+    }
+
+    // Ramps last a whole number of kernel runs. Targets only change between
+    // runs, so every run sees a single straight segment of each ramp and the
+    // result doesn't depend on how the caller splits its blocks.
+    const auto getRampSteps = [sampleRate](double seconds)
+    {
+        return juce::jmax(1, juce::roundToInt(sampleRate * seconds / maxKernelBlock)) * maxKernelBlock;
+    };
+
+    const int smoothSteps = getRampSteps(0.01);
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        damping[channel].reset(smoothSteps);
+        feedback[channel].reset(smoothSteps);
+    }
+    midLevel.reset(smoothSteps);
+    sideLevel.reset(smoothSteps);
+
+    // Tier changes crossfade over a longer window than parameter changes
+    const int tierFadeSteps = getRampSteps(0.05);
+    for (auto &gain : combGains)
+        gain.reset(tierFadeSteps);
+    for (auto &mix : allPassMixes)
+        mix.reset(tierFadeSteps);
+
+    reset();
+}
+
+void ReverbTank::reset()
+{
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        for (int i = 0; i < numCombs; ++i)
+        {
+            if (combBank.buffers[channel][i] != nullptr)
+                juce::FloatVectorOperations::clear(combBank.buffers[channel][i], combBank.sizes[channel][i]);
+            combBank.indices[channel][i] = 0;
+            combBank.last[channel][i] = 0.0f;
+        }
+    }
+
+    for (auto &channelAllPasses : allPasses)
+    {
+        for (auto &allPass : channelAllPasses)
+        {
+            if (allPass.buffer != nullptr)
+                juce::FloatVectorOperations::clear(allPass.buffer, allPass.size);
+            allPass.index = 0;
+        }
+    }
+}
+
+float ReverbTank::getCombFeedback(float roomSize)
+{
+    const float roomScaleFactor = 0.28f;
+    const float roomOffset = 0.7f;
+
+    return roomSize * roomScaleFactor + roomOffset;
+}
+
+void ReverbTank::setParameters(float roomSize, float dampingAmount, bool frozen)
+{
+    mainRoomSize = roomSize;
+    mainDamping = dampingAmount;
+    isFrozen = frozen;
+    inputGain = frozen ? 0.0f : 0.015f;
+
+    updateChannelTargets();
+}
+
+void ReverbTank::setSideParameters(float roomSize, float dampingAmount)
+{
+    sideRoomSize = roomSize;
+    sideDamping = dampingAmount;
+
+    updateChannelTargets();
+}
+
+void ReverbTank::setMidSideLevels(float newMidLevel, float newSideLevel)
+{
+    midLevel.setTargetValue(newMidLevel);
+    sideLevel.setTargetValue(newSideLevel);
+}
+
+void ReverbTank::setMidSide(bool shouldUseMidSide)
+{
+    if (shouldUseMidSide == midSide)
+        return;
+
+    midSide = shouldUseMidSide;
+
+    // The combs hold the other mode's signal; start the new one from silence
+    // with its tuning already in place
+    reset();
+    updateChannelTargets();
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        damping[channel].setCurrentAndTargetValue(damping[channel].getTargetValue());
+        feedback[channel].setCurrentAndTargetValue(feedback[channel].getTargetValue());
+    }
+    midLevel.setCurrentAndTargetValue(midLevel.getTargetValue());
+    sideLevel.setCurrentAndTargetValue(sideLevel.getTargetValue());
+}
+
+void ReverbTank::updateChannelTargets()
+{
+    const float dampScaleFactor = 0.4f;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const bool isSide = midSide && channel == 1;
+
+        if (isFrozen)
+        {
+            damping[channel].setTargetValue(0.0f);
+            feedback[channel].setTargetValue(1.0f);
+        }
+        else
+        {
+            damping[channel].setTargetValue((isSide ? sideDamping : mainDamping) * dampScaleFactor);
+            feedback[channel].setTargetValue(getCombFeedback(isSide ? sideRoomSize : mainRoomSize));
+        }
+    }
+}
+
+int ReverbTank::getNumCombs(QualityTier tierToUse)
+{
+    switch (tierToUse)
+    {
+    case QualityTier::eco:
+        return 4;
+    case QualityTier::normal:
+        return 6;
+    case QualityTier::high:
+    default:
+        return numCombs;
+    }
+}
+
+int ReverbTank::getNumAllPasses(QualityTier tierToUse)
+{
+    return tierToUse == QualityTier::eco ? 2 : numAllPasses;
+}
+
+void ReverbTank::setQualityTier(QualityTier newTier)
+{
+    if (newTier == tier)
+        return;
+
+    tier = newTier;
+
+    // Combs sum roughly incoherently, so compensate the level by the
+    // square root of the active count
+    const int activeCombs = getNumCombs(tier);
+    const float combLevel = std::sqrt(static_cast<float>(numCombs) / static_cast<float>(activeCombs));
+
+    for (int j = 0; j < numCombs; ++j)
+    {
+        // A stage that has been asleep holds stale samples; start it from silence
+        if (j >= combsToRun && j < activeCombs)
+        {
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                juce::FloatVectorOperations::clear(combBank.buffers[channel][j], combBank.sizes[channel][j]);
+                combBank.last[channel][j] = 0.0f;
+            }
+        }
+
+        combGains[j].setTargetValue(j < activeCombs ? combLevel : 0.0f);
+    }
+
+    const int activeAllPasses = getNumAllPasses(tier);
+
+    for (int j = 0; j < numAllPasses; ++j)
+    {
+        if (j >= allPassesToRun && j < activeAllPasses)
+            for (auto &channelAllPasses : allPasses)
+                juce::FloatVectorOperations::clear(channelAllPasses[j].buffer, channelAllPasses[j].size);
+
+        allPassMixes[j].setTargetValue(j < activeAllPasses ? 1.0f : 0.0f);
+    }
+
+    updateStagesToRun();
+}
+
+void ReverbTank::updateStagesToRun()
+{
+    // Tiers always drop stages from the end, so only a prefix ever runs
+    combsToRun = 0;
+    for (int j = 0; j < numCombs; ++j)
+        if (combGains[j].getTargetValue() > 0.0f || combGains[j].isSmoothing())
+            combsToRun = j + 1;
+
+    allPassesToRun = 0;
+    for (int j = 0; j < numAllPasses; ++j)
+        if (allPassMixes[j].getTargetValue() > 0.0f || allPassMixes[j].isSmoothing())
+            allPassesToRun = j + 1;
+}
+
+void ReverbTank::process(const float *inLeft, const float *inRight,
+                         float *outLeft, float *outRight, int numSamples) noexcept
+{
+    const auto &kernels = DspKernels::get();
+
+    for (int offset = 0; offset < numSamples; offset += maxKernelBlock)
+    {
+        const int numThisTime = juce::jmin(maxKernelBlock, numSamples - offset);
+
+        // Mono tank input, or the mid and side pair; copied out first since
+        // the output may alias it
+        alignas(64) float input[2][maxKernelBlock];
+        juce::FloatVectorOperations::add(input[0], inLeft + offset, inRight + offset, numThisTime);
+        juce::FloatVectorOperations::multiply(input[0], inputGain, numThisTime);
+
+        if (midSide)
+        {
+            juce::FloatVectorOperations::subtract(input[1], inLeft + offset, inRight + offset, numThisTime);
+            juce::FloatVectorOperations::multiply(input[1], inputGain, numThisTime);
+        }
+
+        // Hand the smoothers to the kernel as linear ramps over this run
+        CombBankRamps ramps;
+        const auto toRamp = [numThisTime](juce::LinearSmoothedValue<float> &value, float &start, float &step)
+        {
+            start = value.getCurrentValue();
+            step = (value.skip(numThisTime) - start) / static_cast<float>(numThisTime);
+        };
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            toRamp(damping[channel], ramps.damp[channel], ramps.dampStep[channel]);
+            toRamp(feedback[channel], ramps.feedback[channel], ramps.feedbackStep[channel]);
+        }
+        for (int j = 0; j < combsToRun; ++j)
+            toRamp(combGains[j], ramps.gains[j], ramps.gainSteps[j]);
+
+        // Accumulate the comb filters in parallel
+        float *wetL = outLeft + offset;
+        float *wetR = outRight + offset;
+        kernels.combBank(combBank, combsToRun, ramps, input[0], midSide ? input[1] : input[0], wetL, wetR, numThisTime);
+
+        // Run the allpass filters in series
+        for (int i = 0; i < numThisTime; ++i)
+        {
+            float outL = wetL[i];
+            float outR = wetR[i];
+
+            for (int j = 0; j < allPassesToRun; ++j)
+            {
+                const float mix = allPassMixes[j].getNextValue();
+                const float processedL = allPasses[0][j].process(outL);
+                const float processedR = allPasses[1][j].process(outR);
+
+                if (mix >= 1.0f)
+                {
+                    outL = processedL;
+                    outR = processedR;
+                }
+                else
+                {
+                    outL += mix * (processedL - outL);
+                    outR += mix * (processedR - outR);
+                }
+            }
+
+            wetL[i] = outL;
+            wetR[i] = outR;
+        }
+
+        // Decode the mid and side tails back to left and right
+        if (midSide)
+        {
+            float midGain, midStep, sideGain, sideStep;
+            toRamp(midLevel, midGain, midStep);
+            toRamp(sideLevel, sideGain, sideStep);
+
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                midGain += midStep;
+                sideGain += sideStep;
+
+                const float mid = wetL[i] * midGain;
+                const float side = wetR[i] * sideGain;
+                wetL[i] = mid + side;
+                wetR[i] = mid - side;
+            }
+        }
+    }
+
+    // Stages that finished fading out stop costing anything from the next block
+    updateStagesToRun();
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayArena.h"
+#include "DspKernels.h"
+
+// Freeverb-style tank: eight parallel damped combs into four series
+// allpasses per channel. Same topology and tuning as juce::Reverb, but the
+// delay lines live in a caller-provided DelayArena, the comb bank runs
+// through the dispatched DspKernels and the output is wet only.
+class ReverbTank
+{
+public:
+    static constexpr int numCombs = CombBankState::maxCombs;
+    static constexpr int numAllPasses = 4;
+
+    // Density tiers: high is the full tank, lower tiers run fewer combs
+    // and diffusion stages
+    enum class QualityTier
+    {
+        eco,
+        normal,
+        high
+    };
+
+    ReverbTank();
+    ~ReverbTank() = default;
+
+    // Floats of arena space prepare() will carve at this sample rate
+    static size_t getRequiredArenaSize(double sampleRate);
+
+    void prepare(double sampleRate, DelayArena &arena);
+    void reset();
+
+    // Tunes both channels, or the mid tank in mid/side mode
+    void setParameters(float roomSize, float damping, bool frozen);
+
+    // Mid/side: the first channel of the tank runs on the mid signal and
+    // the second on the side, each with its own size and damping, and the
+    // pair is decoded back to left/right with separate levels. Both still
+    // run in the one comb kernel pass. Switching clears the tank, so the
+    // caller should fade the output around it.
+    void setMidSide(bool shouldUseMidSide);
+    bool isMidSide() const { return midSide; }
+
+    // Only heard in mid/side mode; freezing follows setParameters()
+    void setSideParameters(float roomSize, float damping);
+    void setMidSideLevels(float midLevel, float sideLevel); // linear gains
+
+    // Comb feedback the tank uses for a room size, when not frozen
+    static float getCombFeedback(float roomSize);
+
+    // Fades stages in or out over a short crossfade; call on the audio thread
+    void setQualityTier(QualityTier newTier);
+    QualityTier getQualityTier() const { return tier; }
+
+    // Reads the input pair and writes the wet pair; the input may alias the output
+    void process(const float *inLeft, const float *inRight,
+                 float *outLeft, float *outRight, int numSamples) noexcept;
+
+private:
+    struct AllPassFilter
+    {
+        float *buffer = nullptr;
+        int size = 0;
+        int index = 0;
+
+        float process(float input) noexcept
+        {
+            const float bufferedValue = buffer[index];
+            float temp = input + (bufferedValue * 0.5f);
+            JUCE_UNDENORMALISE(temp);
+            buffer[index] = temp;
+            if (++index >= size)
+                index = 0;
+            return bufferedValue - input;
+        }
+    };
+
+    // Delay lengths in samples at the given rate
+    static int getCombLength(int channel, int comb, double sampleRate);
+    static int getAllPassLength(int channel, int allPass, double sampleRate);
+
+    static int getNumCombs(QualityTier tierToUse);
+    static int getNumAllPasses(QualityTier tierToUse);
+
+    // Number of leading stages that are active or still fading out
+    void updateStagesToRun();
+
+    // Points each channel's smoothers at the tuning for the current mode
+    void updateChannelTargets();
+
+    // Longest run handed to the comb kernel in one call
+    static constexpr int maxKernelBlock = 64;
+
+    CombBankState combBank;
+    AllPassFilter allPasses[2][numAllPasses];
+
+    // Per-stage crossfade gains. Combs are level-compensated for the
+    // number active; allpasses blend between bypass and processed
+    juce::LinearSmoothedValue<float> combGains[numCombs];
+    juce::LinearSmoothedValue<float> allPassMixes[numAllPasses];
+    int combsToRun = numCombs;
+    int allPassesToRun = numAllPasses;
+
+    QualityTier tier = QualityTier::high;
+
+    float inputGain = 0.015f;
+
+    // Per channel, so mid/side mode can tune the two tanks apart
+    juce::LinearSmoothedValue<float> damping[2], feedback[2];
+
+    // Requested tunings; the side one only applies in mid/side mode
+    float mainRoomSize = 0.5f, mainDamping = 0.5f;
+    float sideRoomSize = 0.5f, sideDamping = 0.5f;
+    bool isFrozen = false;
+
+    bool midSide = false;
+    juce::LinearSmoothedValue<float> midLevel, sideLevel;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReverbTank)
+};
@@ -0,0 +1,137 @@
+#include "TailReverser.h"
+
+int TailReverser::getHistoryLength(int maxWindowLength, int maxBlockSize)
+{
+    // A grain reads back at most twice its length from the newest sample
+    return juce::nextPowerOfTwo(2 * maxWindowLength + maxBlockSize);
+}
+
+size_t TailReverser::getRequiredArenaSize(int maxWindowLength, int maxBlockSize)
+{
+    return 2 * DelayArena::paddedSize(getHistoryLength(maxWindowLength, maxBlockSize));
+}
+
+void TailReverser::prepare(double sampleRate, int maxWindowLength, int maxBlockSize, DelayArena &arena)
+{
+    fadeInLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.02));
+    fadeInPosition = fadeInLength;
+
+    const int historyLength = getHistoryLength(maxWindowLength, maxBlockSize);
+    historyMask = historyLength - 1;
+    history[0] = arena.carve(historyLength);
+    history[1] = arena.carve(historyLength);
+
+    maxWindow = maxWindowLength;
+    if (windowLength <= 0 || windowLength > maxWindow)
+        windowLength = maxWindow;
+
+    // The arena comes zeroed, and leaving the history untouched keeps its
+    // pages out of memory until reverse mode is first used
+    historyWritten = false;
+    historyPagedIn = false;
+    restartGrains();
+}
+
+void TailReverser::reset()
+{
+    // Clearing a history that was never written would page it in for nothing
+    if (historyWritten)
+        for (auto *channel : history)
+            juce::FloatVectorOperations::clear(channel, historyMask + 1);
+
+    historyWritten = false;
+
+    fadeInPosition = 0;
+    restartGrains();
+}
+
+size_t TailReverser::getTouchedArenaSize() const
+{
+    return historyPagedIn ? 2 * DelayArena::paddedSize(historyMask + 1) : 0;
+}
+
+void TailReverser::restartGrains()
+{
+    writeIndex = 0;
+
+    // Half a window apart, so the triangles always sum to one
+    for (int g = 0; g < 2; ++g)
+    {
+        grains[g].length = windowLength;
+        grains[g].age = g * windowLength / 2;
+        grains[g].start = writeIndex - grains[g].age;
+    }
+}
+
+void TailReverser::restartGrain(int index, int start)
+{
+    auto &grain = grains[index];
+    grain.start = start;
+    grain.age = 0;
+    grain.length = windowLength;
+
+    // The other grain is at its peak. Refit its fall to the current length,
+    // reading on from where it is, so it restarts half a window from now and
+    // the triangles keep summing to one across a length change.
+    auto &other = grains[1 - index];
+    other.start += windowLength / 2 - other.age;
+    other.age = windowLength / 2;
+    other.length = windowLength;
+}
+
+void TailReverser::setWindowLength(int newLength)
+{
+    windowLength = juce::jlimit(2, juce::jmax(2, maxWindow), newLength & ~1);
+}
+
+void TailReverser::process(float *left, float *right, int numSamples) noexcept
+{
+    float *channels[2] = {left, right};
+
+    for (int i = 0; i < numSamples && fadeInPosition < fadeInLength; ++i, ++fadeInPosition)
+    {
+        const float gain = static_cast<float>(fadeInPosition) / static_cast<float>(fadeInLength);
+        left[i] *= gain;
+        right[i] *= gain;
+    }
+
+    // Append the block first; grains only ever read behind it
+    if (!historyWritten)
+    {
+        historyWritten = true;
+        historyPagedIn = true;
+    }
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const int firstRun = juce::jmin(numSamples, historyMask + 1 - writeIndex);
+        juce::FloatVectorOperations::copy(history[channel] + writeIndex, channels[channel], firstRun);
+        juce::FloatVectorOperations::copy(history[channel], channels[channel] + firstRun, numSamples - firstRun);
+    }
+
+    juce::FloatVectorOperations::clear(left, numSamples);
+    juce::FloatVectorOperations::clear(right, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int g = 0; g < 2; ++g)
+            if (grains[g].age >= grains[g].length)
+                restartGrain(g, writeIndex + i);
+
+        for (auto &grain : grains)
+        {
+            // Rises over the first half of the grain, falls over the second
+            const float halfLength = 0.5f * static_cast<float>(grain.length);
+            const float weight = 1.0f - std::abs(static_cast<float>(grain.age) - halfLength) / halfLength;
+
+            // Walks backwards from the sample before the grain started
+            const int index = (grain.start - 1 - grain.age) & historyMask;
+            left[i] += weight * history[0][index];
+            right[i] += weight * history[1][index];
+
+            ++grain.age;
+        }
+    }
+
+    writeIndex = (writeIndex + numSamples) & historyMask;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayArena.h"
+
+// Plays the wet signal backwards in overlapping windows for reverse
+// reverb. Two grains each read one window of history backwards under a
+// triangular window, half a window apart, so each stretch of tail is heard
+// reversed one window later; the plugin reports that window as latency.
+// A new window length takes effect at the next grain restart, which also
+// retimes the other grain to stay half a window behind.
+class TailReverser
+{
+public:
+    TailReverser() = default;
+    ~TailReverser() = default;
+
+    // Floats of arena space prepare() will carve
+    static size_t getRequiredArenaSize(int maxWindowLength, int maxBlockSize);
+
+    void prepare(double sampleRate, int maxWindowLength, int maxBlockSize, DelayArena &arena);
+    void reset();
+
+    // Window length in samples, even and at most the prepared maximum
+    void setWindowLength(int newLength);
+
+    void process(float *left, float *right, int numSamples) noexcept;
+
+    // Floats of history written since prepare(); the rest of the carve has
+    // never been paged in. Safe to call from any thread.
+    size_t getTouchedArenaSize() const;
+
+private:
+    struct Grain
+    {
+        int start = 0;
+        int age = 0;
+        int length = 0;
+    };
+
+    static int getHistoryLength(int maxWindowLength, int maxBlockSize);
+
+    void restartGrains();
+
+    // Starts one grain at the current window length and refits the other
+    void restartGrain(int index, int start);
+
+    float *history[2] = {};
+    int historyMask = 0;
+    int writeIndex = 0;
+
+    int maxWindow = 0;
+    int windowLength = 0;
+
+    // Ramps the input in after a reset, so the cleared history doesn't
+    // play back as a hard cut one window later
+    int fadeInLength = 0;
+    int fadeInPosition = 0;
+
+    // Whether the history has been written since it was last cleared, and
+    // whether it has been at all since prepare()
+    bool historyWritten = false;
+    std::atomic<bool> historyPagedIn{false};
+
+    Grain grains[2];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TailReverser)
+};
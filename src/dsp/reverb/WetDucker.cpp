@@ -0,0 +1,114 @@
+#include "WetDucker.h"
+
+namespace
+{
+    constexpr double attackSeconds = 0.005;
+    constexpr double minReleaseSeconds = 0.05;
+    constexpr double maxReleaseSeconds = 2.0;
+    constexpr float maxDepthDecibels = 30.0f;
+}
+
+size_t WetDucker::getRequiredArenaSize(int maxBlockSize)
+{
+    return DelayArena::paddedSize(maxBlockSize);
+}
+
+void WetDucker::prepare(double sampleRate, int maxBlockSize, DelayArena &arena)
+{
+    currentSampleRate = sampleRate;
+    maxBlock = maxBlockSize;
+    gainRamp = arena.carve(maxBlockSize);
+
+    reset();
+}
+
+void WetDucker::reset()
+{
+    envelope = 0.0f;
+    gain = 1.0f;
+    gainStep = 0.0f;
+    targetGain = 1.0f;
+    intervalPeak = 0.0f;
+    intervalPosition = 0;
+}
+
+void WetDucker::setAmount(float newAmount)
+{
+    depthDecibels = maxDepthDecibels * juce::jlimit(0.0f, 1.0f, newAmount);
+}
+
+void WetDucker::setThreshold(float newThreshold)
+{
+    thresholdDecibels = -60.0f + 60.0f * juce::jlimit(0.0f, 1.0f, newThreshold);
+}
+
+void WetDucker::setRelease(float newRelease)
+{
+    releaseSeconds = minReleaseSeconds + (maxReleaseSeconds - minReleaseSeconds) * juce::jlimit(0.0f, 1.0f, newRelease);
+}
+
+float WetDucker::getIntervalCoefficient(double seconds) const
+{
+    return static_cast<float>(std::exp(-maxBlock / (seconds * currentSampleRate)));
+}
+
+void WetDucker::process(const float *keyLeft, const float *keyRight,
+                        float *wetLeft, float *wetRight, int numSamples) noexcept
+{
+    for (int offset = 0, numThisTime = 0; offset < numSamples; offset += numThisTime)
+    {
+        numThisTime = juce::jmin(maxBlock - intervalPosition, numSamples - offset);
+        intervalPosition += numThisTime;
+
+        // Off and fully recovered: leave the wet path alone
+        if (depthDecibels <= 0.0f && gain >= 1.0f && gainStep == 0.0f)
+        {
+            envelope = 0.0f;
+            intervalPeak = 0.0f;
+            intervalPosition %= maxBlock;
+            continue;
+        }
+
+        // Interval peak of the key from its extremes
+        const auto rangeLeft = juce::FloatVectorOperations::findMinAndMax(keyLeft + offset, numThisTime);
+        const auto rangeRight = juce::FloatVectorOperations::findMinAndMax(keyRight + offset, numThisTime);
+        intervalPeak = juce::jmax(intervalPeak, -rangeLeft.getStart(), rangeLeft.getEnd(),
+                                  juce::jmax(-rangeRight.getStart(), rangeRight.getEnd()));
+
+        // Settled at unity there is nothing to apply
+        if (gain < 1.0f || gainStep != 0.0f)
+        {
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                gain += gainStep;
+                gainRamp[i] = gain;
+            }
+
+            juce::FloatVectorOperations::multiply(wetLeft + offset, gainRamp, numThisTime);
+            juce::FloatVectorOperations::multiply(wetRight + offset, gainRamp, numThisTime);
+        }
+
+        if (intervalPosition == maxBlock)
+            endInterval();
+    }
+}
+
+void WetDucker::endInterval() noexcept
+{
+    const float coefficient = getIntervalCoefficient(intervalPeak > envelope ? attackSeconds : releaseSeconds);
+    envelope = intervalPeak + coefficient * (envelope - intervalPeak);
+
+    // Land the ramp exactly, then head for the gain this interval calls for
+    gain = targetGain;
+
+    // Reduce by how far the key is over the threshold, up to the depth
+    const float overDecibels = juce::Decibels::gainToDecibels(envelope) - thresholdDecibels;
+    const float reduction = juce::jlimit(0.0f, depthDecibels, overDecibels);
+    targetGain = juce::Decibels::decibelsToGain(-reduction);
+
+    // Ramp from the last interval's gain so the steps between them are inaudible
+    gainStep = (targetGain - gain) / static_cast<float>(maxBlock);
+
+    intervalPeak = 0.0f;
+    intervalPosition = 0;
+}
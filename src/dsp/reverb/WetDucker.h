@@ -0,0 +1,59 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayArena.h"
+
+// Ducks the wet pair under a key signal, so the tail sits back while the
+// key plays and swells up in the gaps. The key peak is found with a
+// vectorised min/max scan over fixed intervals of the sample stream, so the
+// ducking doesn't depend on how calls split it, and run through an
+// attack/release follower at interval rate. Each interval's gain is ramped
+// across the next in a scratch buffer and applied as a vector multiply.
+class WetDucker
+{
+public:
+    WetDucker() = default;
+    ~WetDucker() = default;
+
+    // Floats of arena space prepare() will carve
+    static size_t getRequiredArenaSize(int maxBlockSize);
+
+    // The key is measured over intervals of maxBlockSize samples
+    void prepare(double sampleRate, int maxBlockSize, DelayArena &arena);
+    void reset();
+
+    void setAmount(float newAmount);       // 0.0 - 1.0, 0dB - 30dB of reduction, 0 is off
+    void setThreshold(float newThreshold); // 0.0 - 1.0, -60dB - 0dB
+    void setRelease(float newRelease);     // 0.0 - 1.0, 50ms - 2s
+
+    void process(const float *keyLeft, const float *keyRight,
+                 float *wetLeft, float *wetRight, int numSamples) noexcept;
+
+private:
+    // Per-interval smoothing coefficient for a time constant
+    float getIntervalCoefficient(double seconds) const;
+
+    // Follows the finished interval's peak and sets the ramp for the next
+    void endInterval() noexcept;
+
+    float *gainRamp = nullptr;
+    int maxBlock = 0;
+
+    double currentSampleRate = 44100.0;
+    float depthDecibels = 0.0f;
+    float thresholdDecibels = -30.0f;
+    double releaseSeconds = 0.3;
+
+    float envelope = 0.0f;
+
+    // Gain ramp across the current interval
+    float gain = 1.0f;
+    float gainStep = 0.0f;
+    float targetGain = 1.0f;
+
+    // Key peak so far in the current interval
+    float intervalPeak = 0.0f;
+    int intervalPosition = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WetDucker)
+};
@@ -0,0 +1,100 @@
+#include "WetGate.h"
+
+namespace
+{
+    constexpr double attackSeconds = 0.001;
+    constexpr double releaseSeconds = 0.05;
+    constexpr double minHoldSeconds = 0.05;
+    constexpr double maxHoldSeconds = 1.0;
+}
+
+size_t WetGate::getRequiredArenaSize(int maxBlockSize)
+{
+    return DelayArena::paddedSize(maxBlockSize);
+}
+
+void WetGate::prepare(double sampleRate, int maxBlockSize, DelayArena &arena)
+{
+    currentSampleRate = sampleRate;
+    maxBlock = maxBlockSize;
+    envelope = arena.carve(maxBlockSize);
+
+    attackStep = static_cast<float>(1.0 / (attackSeconds * sampleRate));
+    releaseStep = static_cast<float>(1.0 / (releaseSeconds * sampleRate));
+
+    reset();
+}
+
+void WetGate::reset()
+{
+    holdRemaining = 0;
+    level = 0.0f;
+    intervalPeak = 0.0f;
+    intervalPosition = 0;
+    open = false;
+}
+
+void WetGate::setThreshold(float newThreshold)
+{
+    thresholdGain = juce::Decibels::decibelsToGain(-60.0f + 60.0f * juce::jlimit(0.0f, 1.0f, newThreshold));
+}
+
+void WetGate::setHold(float newHold)
+{
+    const double seconds = minHoldSeconds + (maxHoldSeconds - minHoldSeconds) * juce::jlimit(0.0f, 1.0f, newHold);
+    holdSamples = juce::roundToInt(seconds * currentSampleRate);
+}
+
+void WetGate::process(const float *keyLeft, const float *keyRight,
+                      float *wetLeft, float *wetRight, int numSamples) noexcept
+{
+    for (int offset = 0, numThisTime = 0; offset < numSamples; offset += numThisTime)
+    {
+        numThisTime = juce::jmin(maxBlock - intervalPosition, numSamples - offset);
+
+        // Interval peak of the key from its extremes
+        const auto rangeLeft = juce::FloatVectorOperations::findMinAndMax(keyLeft + offset, numThisTime);
+        const auto rangeRight = juce::FloatVectorOperations::findMinAndMax(keyRight + offset, numThisTime);
+        intervalPeak = juce::jmax(intervalPeak, -rangeLeft.getStart(), rangeLeft.getEnd(),
+                                  juce::jmax(-rangeRight.getStart(), rangeRight.getEnd()));
+
+        applyEnvelope(wetLeft + offset, wetRight + offset, numThisTime);
+
+        intervalPosition += numThisTime;
+        if (intervalPosition < maxBlock)
+            continue;
+
+        if (intervalPeak >= thresholdGain)
+            holdRemaining = holdSamples;
+        else
+            holdRemaining = juce::jmax(0, holdRemaining - maxBlock);
+
+        open = holdRemaining > 0;
+        intervalPeak = 0.0f;
+        intervalPosition = 0;
+    }
+}
+
+void WetGate::applyEnvelope(float *wetLeft, float *wetRight, int numSamples) noexcept
+{
+    // Settled states need no envelope
+    if (open && level >= 1.0f)
+        return;
+
+    if (!open && level <= 0.0f)
+    {
+        juce::FloatVectorOperations::clear(wetLeft, numSamples);
+        juce::FloatVectorOperations::clear(wetRight, numSamples);
+        return;
+    }
+
+    const float step = open ? attackStep : -releaseStep;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        level = juce::jlimit(0.0f, 1.0f, level + step);
+        envelope[i] = level;
+    }
+
+    juce::FloatVectorOperations::multiply(wetLeft, envelope, numSamples);
+    juce::FloatVectorOperations::multiply(wetRight, envelope, numSamples);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayArena.h"
+
+// Gate on the wet pair keyed by the dry input, for gated reverb. The key
+// level is found with a vectorised min/max scan over fixed intervals of the
+// sample stream, so the gate doesn't depend on how calls split it; each
+// interval's level opens the gate for the next while it exceeds the
+// threshold, then it holds and releases. The gain envelope is built into a
+// scratch buffer and applied as a vector multiply.
+class WetGate
+{
+public:
+    WetGate() = default;
+    ~WetGate() = default;
+
+    // Floats of arena space prepare() will carve
+    static size_t getRequiredArenaSize(int maxBlockSize);
+
+    // The key is measured over intervals of maxBlockSize samples
+    void prepare(double sampleRate, int maxBlockSize, DelayArena &arena);
+    void reset();
+
+    void setThreshold(float newThreshold); // 0.0 - 1.0, -60dB - 0dB
+    void setHold(float newHold);           // 0.0 - 1.0, 50ms - 1s
+
+    void process(const float *keyLeft, const float *keyRight,
+                 float *wetLeft, float *wetRight, int numSamples) noexcept;
+
+private:
+    float *envelope = nullptr;
+    int maxBlock = 0;
+
+    double currentSampleRate = 44100.0;
+    float thresholdGain = 0.0316f;
+    int holdSamples = 0;
+    int holdRemaining = 0;
+
+    // Key peak so far in the current interval, and the decision from the last
+    float intervalPeak = 0.0f;
+    int intervalPosition = 0;
+    bool open = false;
+
+    float level = 0.0f;
+    float attackStep = 1.0f;
+    float releaseStep = 1.0f;
+
+    // Runs the envelope over part of one interval
+    void applyEnvelope(float *wetLeft, float *wetRight, int numSamples) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WetGate)
+};
@@ -0,0 +1,124 @@
+#include "DspKernels.h"
+
+namespace
+{
+    const DspKernels *getTable(DspKernels::Isa isa)
+    {
+        switch (isa)
+        {
+        case DspKernels::Isa::sse2:
+            return DspKernels::getSse2Kernels();
+        case DspKernels::Isa::avx2:
+            return DspKernels::getAvx2Kernels();
+        case DspKernels::Isa::avx512:
+            return DspKernels::getAvx512Kernels();
+        case DspKernels::Isa::scalar:
+        default:
+            return DspKernels::getScalarKernels();
+        }
+    }
+
+    std::atomic<const DspKernels *> &getBinding()
+    {
+        // Bound on first use, before any audio thread can read it
+        static std::atomic<const DspKernels *> binding{getTable(DspKernels::getDefaultIsa())};
+        return binding;
+    }
+}
+
+int CombBankState::getRunLength(int channel, int numCombs, int numSamples) const noexcept
+{
+    int length = juce::jmin(maxRun, numSamples);
+    for (int j = 0; j < numCombs; ++j)
+        length = juce::jmin(length, sizes[channel][j]);
+    return length;
+}
+
+void CombBankState::readRun(int channel, int comb, float *taps, int numSamples) const noexcept
+{
+    const float *buffer = buffers[channel][comb];
+    const int index = indices[channel][comb];
+    const int beforeWrap = juce::jmin(numSamples, sizes[channel][comb] - index);
+
+    std::copy(buffer + index, buffer + index + beforeWrap, taps);
+    std::copy(buffer, buffer + numSamples - beforeWrap, taps + beforeWrap);
+}
+
+void CombBankState::writeRun(int channel, int comb, const float *samples, int numSamples) noexcept
+{
+    float *buffer = buffers[channel][comb];
+    int &index = indices[channel][comb];
+    const int beforeWrap = juce::jmin(numSamples, sizes[channel][comb] - index);
+
+    std::copy(samples, samples + beforeWrap, buffer + index);
+    std::copy(samples + beforeWrap, samples + numSamples, buffer);
+
+    index += numSamples;
+    if (index >= sizes[channel][comb])
+        index -= sizes[channel][comb];
+}
+
+const DspKernels &DspKernels::get()
+{
+    return *getBinding().load(std::memory_order_acquire);
+}
+
+bool DspKernels::isSupported(Isa isa)
+{
+    if (getTable(isa) == nullptr)
+        return false;
+
+    switch (isa)
+    {
+    case Isa::sse2:
+        return juce::SystemStats::hasSSE2();
+    case Isa::avx2:
+        return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3();
+    case Isa::avx512:
+        // The biquad loop is built with FMA as well as AVX-512F
+        return juce::SystemStats::hasAVX512F() && juce::SystemStats::hasFMA3();
+    case Isa::scalar:
+    default:
+        return true;
+    }
+}
+
+DspKernels::Isa DspKernels::getDefaultIsa()
+{
+    const juce::String forced = juce::SystemStats::getEnvironmentVariable("RUPTURE_FORCE_ISA", {}).trim().toLowerCase();
+
+    for (auto isa : {Isa::scalar, Isa::sse2, Isa::avx2, Isa::avx512})
+        if (forced == getIsaName(isa) && isSupported(isa))
+            return isa;
+
+    for (auto isa : {Isa::avx512, Isa::avx2, Isa::sse2})
+        if (isSupported(isa))
+            return isa;
+
+    return Isa::scalar;
+}
+
+bool DspKernels::forceIsa(Isa isa)
+{
+    if (!isSupported(isa))
+        return false;
+
+    getBinding().store(getTable(isa), std::memory_order_release);
+    return true;
+}
+
+const char *DspKernels::getIsaName(Isa isa)
+{
+    switch (isa)
+    {
+    case Isa::sse2:
+        return "sse2";
+    case Isa::avx2:
+        return "avx2";
+    case Isa::avx512:
+        return "avx512";
+    case Isa::scalar:
+    default:
+        return "scalar";
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Stereo bank of up to eight parallel damped combs per channel, kept in
+// structure-of-arrays form so a vector kernel can hold one comb per lane
+struct CombBankState
+{
+    static constexpr int maxCombs = 8;
+
+    // Longest run of samples the vector kernels move through the delay lines
+    // at once
+    static constexpr int maxRun = 32;
+
+    float *buffers[2][maxCombs] = {};
+    int sizes[2][maxCombs] = {};
+    int indices[2][maxCombs] = {};
+    alignas(64) float last[2][maxCombs] = {};
+
+    // Length of the next run over numSamples: at most maxRun, and no longer
+    // than any of the channel's first numCombs combs, so no comb reads a
+    // sample written in the same run. A run's taps can then be read up front
+    // and its new samples stored afterwards, as contiguous copies.
+    int getRunLength(int channel, int numCombs, int numSamples) const noexcept;
+
+    // Copies a run of a comb's taps out, or its new samples back in over
+    // the same positions; writing advances the comb's index past the run
+    void readRun(int channel, int comb, float *taps, int numSamples) const noexcept;
+    void writeRun(int channel, int comb, const float *samples, int numSamples) noexcept;
+};
+
+// Per-block linear ramps for the comb bank. Each value is advanced by its
+// step before use, matching juce::LinearSmoothedValue::getNextValue().
+// Damping and feedback are per channel so the two halves can be tuned apart.
+struct CombBankRamps
+{
+    float damp[2] = {}, dampStep[2] = {};
+    float feedback[2] = {}, feedbackStep[2] = {};
+    alignas(64) float gains[CombBankState::maxCombs] = {};
+    alignas(64) float gainSteps[CombBankState::maxCombs] = {};
+};
+
+// Cascade of second-order sections run on a stereo pair with shared
+// coefficients, in transposed direct form II. Coefficients are normalised
+// so a0 is 1. Inactive stages are skipped and must hold a cleared state.
+struct StereoBiquadCascade
+{
+    static constexpr int maxStages = 4;
+
+    struct Coefficients
+    {
+        float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    };
+
+    Coefficients coefficients[maxStages];
+    bool active[maxStages] = {};
+
+    // Per stage {s1 left, s1 right, s2 left, s2 right}, so one 128-bit
+    // register holds the whole state of a stage
+    alignas(16) float state[maxStages][4] = {};
+};
+
+// Table of DSP inner loops, bound once at startup to the best variant the
+// CPU supports. Every variant computes the same thing; results may differ
+// in the last bits where vector code reorders sums or fuses multiply-adds.
+struct DspKernels
+{
+    enum class Isa
+    {
+        scalar,
+        sse2,
+        avx2,   // AVX2 + FMA
+        avx512  // AVX-512F + FMA
+    };
+
+    // Runs numCombs combs of both channels, each channel over its own mono
+    // input (both may point at the same one), writing the gain-weighted sum
+    // of each channel's comb outputs
+    using CombBankFn = void (*)(CombBankState &bank, int numCombs, const CombBankRamps &ramps,
+                                const float *inLeft, const float *inRight,
+                                float *outLeft, float *outRight, int numSamples);
+
+    // output[i] += sum over j of coefficients[j] * input[i - j]
+    using FirAccumulateFn = void (*)(float *output, const float *input, const float *coefficients,
+                                     int numTaps, int numSamples);
+
+    // Sum of squared samples, for RMS metering
+    using SumOfSquaresFn = float (*)(const float *input, int numSamples);
+
+    // Runs the active stages of the cascade over both channels in place
+    using BiquadCascadeFn = void (*)(StereoBiquadCascade &cascade, float *left, float *right, int numSamples);
+
+    Isa isa;
+    CombBankFn combBank;
+    FirAccumulateFn firAccumulate;
+    SumOfSquaresFn sumOfSquares;
+    BiquadCascadeFn biquadCascade;
+
+    // Kernels currently in use; cheap enough to call once per block
+    static const DspKernels &get();
+
+    // Best variant for this CPU. The RUPTURE_FORCE_ISA environment variable
+    // (scalar, sse2, avx2 or avx512) overrides it when that variant can run.
+    static Isa getDefaultIsa();
+
+    static bool isSupported(Isa isa);
+
+    // Rebinds every kernel to one variant, for tests and benchmarks.
+    // Returns false, leaving the binding alone, if the CPU can't run it.
+    static bool forceIsa(Isa isa);
+
+    static const char *getIsaName(Isa isa);
+
+    // Variant tables; the x86 ones are null on other architectures
+    static const DspKernels *getScalarKernels();
+    static const DspKernels *getSse2Kernels();
+    static const DspKernels *getAvx2Kernels();
+    static const DspKernels *getAvx512Kernels();
+};
+
+// Enables an instruction set for a single function, so vector variants can
+// live in a build that targets the baseline ISA
+#if JUCE_MSVC
+ #define RUPTURE_TARGET(isaName)
+#else
+ #define RUPTURE_TARGET(isaName) __attribute__((target(isaName)))
+#endif
@@ -0,0 +1,307 @@
+#include "DspKernels.h"
+
+#if JUCE_INTEL
+
+#include <immintrin.h>
+
+namespace
+{
+    RUPTURE_TARGET("avx2,fma")
+    inline float horizontalSum(__m256 v)
+    {
+        __m128 x = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+        x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+        return _mm_cvtss_f32(_mm_add_ss(x, _mm_shuffle_ps(x, x, 1)));
+    }
+
+    // Transposes an 8x8 block: row k of the source becomes lane k of each
+    // destination row. Half rows are loaded straight into place, which
+    // leaves two shuffle stages instead of three.
+    RUPTURE_TARGET("avx2,fma")
+    inline void transpose8x8(const float *const *sources, float *const *destinations)
+    {
+        for (int half = 0; half < 8; half += 4)
+        {
+            __m256 r[4], t[4];
+            for (int k = 0; k < 4; ++k)
+                r[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(sources[k] + half)),
+                                            _mm_loadu_ps(sources[k + 4] + half), 1);
+
+            t[0] = _mm256_unpacklo_ps(r[0], r[1]);
+            t[1] = _mm256_unpackhi_ps(r[0], r[1]);
+            t[2] = _mm256_unpacklo_ps(r[2], r[3]);
+            t[3] = _mm256_unpackhi_ps(r[2], r[3]);
+
+            _mm256_storeu_ps(destinations[half], _mm256_shuffle_ps(t[0], t[2], _MM_SHUFFLE(1, 0, 1, 0)));
+            _mm256_storeu_ps(destinations[half + 1], _mm256_shuffle_ps(t[0], t[2], _MM_SHUFFLE(3, 2, 3, 2)));
+            _mm256_storeu_ps(destinations[half + 2], _mm256_shuffle_ps(t[1], t[3], _MM_SHUFFLE(1, 0, 1, 0)));
+            _mm256_storeu_ps(destinations[half + 3], _mm256_shuffle_ps(t[1], t[3], _MM_SHUFFLE(3, 2, 3, 2)));
+        }
+    }
+
+    // One register per channel, a comb per lane, both channels through the
+    // filters together. Each run's taps are summed across combs a register
+    // of samples at a time and transposed to one sample per register for
+    // the filters; the new samples are transposed back into the delay lines.
+    // Runs that don't wrap work on the delay lines in place.
+    RUPTURE_TARGET("avx2,fma")
+    void combBankAvx2(CombBankState &bank, int numCombs, const CombBankRamps &ramps,
+                      const float *inLeft, const float *inRight,
+                      float *outLeft, float *outRight, int numSamples)
+    {
+        constexpr int maxCombs = CombBankState::maxCombs;
+        constexpr int maxRun = CombBankState::maxRun;
+        const float *inputs[2] = {inLeft, inRight};
+        float *outputs[2] = {outLeft, outRight};
+        const __m256 denormalOffset = _mm256_set1_ps(0.1f);
+        const __m256 rampOffsets = _mm256_setr_ps(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+
+        // Copies of the runs that wrap, silence for the combs beyond
+        // numCombs and somewhere for their output to go
+        alignas(32) float copies[2][maxCombs][maxRun] = {};
+        alignas(32) float silence[maxRun] = {};
+        alignas(32) float discard[maxRun];
+
+        // Each sample's taps, then its new samples: left combs, then right
+        alignas(32) float lanes[maxRun][2 * maxCombs];
+        alignas(32) float sums[maxRun];
+
+        // Per-sample damping and feedback, broadcast from memory in the filters
+        alignas(32) float damps[2][maxRun], undamped[2][maxRun], feedbacks[2][maxRun];
+
+        __m256 last[2] = {_mm256_load_ps(bank.last[0]), _mm256_load_ps(bank.last[1])};
+        float damp[2] = {ramps.damp[0], ramps.damp[1]};
+        float feedback[2] = {ramps.feedback[0], ramps.feedback[1]};
+        float gains[maxCombs];
+        std::copy(ramps.gains, ramps.gains + numCombs, gains);
+
+        for (int offset = 0, numThisTime = 0; offset < numSamples; offset += numThisTime)
+        {
+            numThisTime = juce::jmin(bank.getRunLength(0, numCombs, numSamples - offset),
+                                     bank.getRunLength(1, numCombs, numSamples - offset));
+
+            const bool wholeRegisters = numThisTime % 8 == 0;
+            const float *taps[2][maxCombs];
+            float *writes[2][maxCombs];
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int j = 0; j < maxCombs; ++j)
+                {
+                    const int index = bank.indices[channel][j];
+
+                    if (j >= numCombs)
+                    {
+                        taps[channel][j] = silence;
+                        writes[channel][j] = discard;
+                    }
+                    else if (wholeRegisters && index + maxRun <= bank.sizes[channel][j])
+                    {
+                        taps[channel][j] = bank.buffers[channel][j] + index;
+                        writes[channel][j] = bank.buffers[channel][j] + index;
+                    }
+                    else
+                    {
+                        bank.readRun(channel, j, copies[channel][j], numThisTime);
+                        taps[channel][j] = copies[channel][j];
+                        writes[channel][j] = copies[channel][j];
+                    }
+                }
+
+                for (int i = 0; i < numThisTime; i += 8)
+                {
+                    const __m256 position = _mm256_add_ps(rampOffsets, _mm256_set1_ps(static_cast<float>(i)));
+                    __m256 sum = _mm256_setzero_ps();
+
+                    for (int j = 0; j < numCombs; ++j)
+                    {
+                        const __m256 gain = _mm256_fmadd_ps(position, _mm256_set1_ps(ramps.gainSteps[j]),
+                                                            _mm256_set1_ps(gains[j]));
+                        sum = _mm256_fmadd_ps(_mm256_loadu_ps(taps[channel][j] + i), gain, sum);
+                    }
+
+                    float *output = outputs[channel] + offset + i;
+                    if (i + 8 <= numThisTime)
+                    {
+                        _mm256_storeu_ps(output, sum);
+                    }
+                    else
+                    {
+                        _mm256_store_ps(sums, sum);
+                        std::copy(sums, sums + numThisTime - i, output);
+                    }
+                }
+
+                for (int i = 0; i < numThisTime; i += 8)
+                {
+                    const float *sources[8];
+                    float *destinations[8];
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        sources[k] = taps[channel][k] + i;
+                        destinations[k] = lanes[i + k] + channel * maxCombs;
+                    }
+                    transpose8x8(sources, destinations);
+                }
+            }
+
+            for (int j = 0; j < numCombs; ++j)
+                gains[j] += ramps.gainSteps[j] * static_cast<float>(numThisTime);
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int i = 0; i < numThisTime; ++i)
+                {
+                    damp[channel] += ramps.dampStep[channel];
+                    feedback[channel] += ramps.feedbackStep[channel];
+                    damps[channel][i] = damp[channel];
+                    undamped[channel][i] = 1.0f - damp[channel];
+                    feedbacks[channel][i] = feedback[channel];
+                }
+            }
+
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    const __m256 tap = _mm256_load_ps(lanes[i] + channel * maxCombs);
+
+                    __m256 l = _mm256_fmadd_ps(last[channel], _mm256_broadcast_ss(&damps[channel][i]),
+                                               _mm256_mul_ps(tap, _mm256_broadcast_ss(&undamped[channel][i])));
+                    l = _mm256_sub_ps(_mm256_add_ps(l, denormalOffset), denormalOffset);
+                    last[channel] = l;
+
+                    __m256 write = _mm256_fmadd_ps(l, _mm256_broadcast_ss(&feedbacks[channel][i]),
+                                                   _mm256_broadcast_ss(inputs[channel] + offset + i));
+                    write = _mm256_sub_ps(_mm256_add_ps(write, denormalOffset), denormalOffset);
+                    _mm256_store_ps(lanes[i] + channel * maxCombs, write);
+                }
+            }
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int i = 0; i < numThisTime; i += 8)
+                {
+                    const float *sources[8];
+                    float *destinations[8];
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        sources[k] = lanes[i + k] + channel * maxCombs;
+                        destinations[k] = writes[channel][k] + i;
+                    }
+                    transpose8x8(sources, destinations);
+                }
+
+                for (int j = 0; j < numCombs; ++j)
+                {
+                    if (writes[channel][j] == copies[channel][j])
+                    {
+                        bank.writeRun(channel, j, copies[channel][j], numThisTime);
+                    }
+                    else
+                    {
+                        int &index = bank.indices[channel][j];
+                        index += numThisTime;
+                        if (index >= bank.sizes[channel][j])
+                            index = 0;
+                    }
+                }
+            }
+        }
+
+        _mm256_store_ps(bank.last[0], last[0]);
+        _mm256_store_ps(bank.last[1], last[1]);
+    }
+
+    RUPTURE_TARGET("avx2,fma")
+    void firAccumulateAvx2(float *output, const float *input, const float *coefficients,
+                           int numTaps, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            __m256 sum = _mm256_loadu_ps(output + i);
+            for (int j = 0; j < numTaps; ++j)
+                sum = _mm256_fmadd_ps(_mm256_set1_ps(coefficients[j]), _mm256_loadu_ps(input + i - j), sum);
+            _mm256_storeu_ps(output + i, sum);
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            float sum = output[i];
+            for (int j = 0; j < numTaps; ++j)
+                sum += coefficients[j] * input[i - j];
+            output[i] = sum;
+        }
+    }
+
+    RUPTURE_TARGET("avx2,fma")
+    float sumOfSquaresAvx2(const float *input, int numSamples)
+    {
+        __m256 sum = _mm256_setzero_ps();
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const __m256 x = _mm256_loadu_ps(input + i);
+            sum = _mm256_fmadd_ps(x, x, sum);
+        }
+
+        float total = horizontalSum(sum);
+        for (; i < numSamples; ++i)
+            total += input[i] * input[i];
+
+        return total;
+    }
+
+    // Same register layout as the SSE2 loop, with fused multiply-adds
+    RUPTURE_TARGET("avx2,fma")
+    void biquadCascadeAvx2(StereoBiquadCascade &cascade, float *left, float *right, int numSamples)
+    {
+        for (int stage = 0; stage < StereoBiquadCascade::maxStages; ++stage)
+        {
+            if (!cascade.active[stage])
+                continue;
+
+            const auto &c = cascade.coefficients[stage];
+            const __m128 b0 = _mm_set1_ps(c.b0);
+            const __m128 b12 = _mm_setr_ps(c.b1, c.b1, c.b2, c.b2);
+            const __m128 a12 = _mm_setr_ps(c.a1, c.a1, c.a2, c.a2);
+            __m128 state = _mm_load_ps(cascade.state[stage]);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const __m128 pair = _mm_unpacklo_ps(_mm_load_ss(left + i), _mm_load_ss(right + i));
+                const __m128 x = _mm_movelh_ps(pair, pair);
+
+                const __m128 y = _mm_fmadd_ps(b0, x, state);
+                const __m128 yy = _mm_movelh_ps(y, y);
+
+                const __m128 carried = _mm_movehl_ps(_mm_setzero_ps(), state);
+                state = _mm_fnmadd_ps(a12, yy, _mm_fmadd_ps(b12, x, carried));
+
+                _mm_store_ss(left + i, y);
+                _mm_store_ss(right + i, _mm_shuffle_ps(y, y, 1));
+            }
+
+            _mm_store_ps(cascade.state[stage], state);
+        }
+    }
+}
+
+const DspKernels *DspKernels::getAvx2Kernels()
+{
+    static const DspKernels kernels{Isa::avx2, combBankAvx2, firAccumulateAvx2, sumOfSquaresAvx2,
+                                    biquadCascadeAvx2};
+    return &kernels;
+}
+
+#else
+
+const DspKernels *DspKernels::getAvx2Kernels()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,296 @@
+#include "DspKernels.h"
+
+#if JUCE_INTEL
+
+#include <immintrin.h>
+
+namespace
+{
+    // Transposes an 8x8 block: row k of the source becomes lane k of each
+    // destination row. Half rows are loaded straight into place, which
+    // leaves two shuffle stages instead of three.
+    RUPTURE_TARGET("avx512f")
+    inline void transpose8x8(const float *const *sources, float *const *destinations)
+    {
+        for (int half = 0; half < 8; half += 4)
+        {
+            __m256 r[4], t[4];
+            for (int k = 0; k < 4; ++k)
+                r[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(sources[k] + half)),
+                                            _mm_loadu_ps(sources[k + 4] + half), 1);
+
+            t[0] = _mm256_unpacklo_ps(r[0], r[1]);
+            t[1] = _mm256_unpackhi_ps(r[0], r[1]);
+            t[2] = _mm256_unpacklo_ps(r[2], r[3]);
+            t[3] = _mm256_unpackhi_ps(r[2], r[3]);
+
+            _mm256_storeu_ps(destinations[half], _mm256_shuffle_ps(t[0], t[2], _MM_SHUFFLE(1, 0, 1, 0)));
+            _mm256_storeu_ps(destinations[half + 1], _mm256_shuffle_ps(t[0], t[2], _MM_SHUFFLE(3, 2, 3, 2)));
+            _mm256_storeu_ps(destinations[half + 2], _mm256_shuffle_ps(t[1], t[3], _MM_SHUFFLE(1, 0, 1, 0)));
+            _mm256_storeu_ps(destinations[half + 3], _mm256_shuffle_ps(t[1], t[3], _MM_SHUFFLE(3, 2, 3, 2)));
+        }
+    }
+
+    // Both channels in one register: lanes 0-7 are the left combs, 8-15 the
+    // right. Damping, feedback and input are per half, so two differently
+    // tuned tanks cost the same as one stereo tank. Each run's taps are
+    // summed across combs a register of samples at a time and transposed to
+    // one sample per register for the filters; the new samples are
+    // transposed back into the delay lines. Runs that don't wrap work on the
+    // delay lines in place.
+    RUPTURE_TARGET("avx512f")
+    void combBankAvx512(CombBankState &bank, int numCombs, const CombBankRamps &ramps,
+                        const float *inLeft, const float *inRight,
+                        float *outLeft, float *outRight, int numSamples)
+    {
+        constexpr int lanesPerChannel = CombBankState::maxCombs;
+        constexpr int maxRun = CombBankState::maxRun;
+        constexpr __mmask16 rightLanes = 0xff00;
+        const __m512 denormalOffset = _mm512_set1_ps(0.1f);
+        const __m512 one = _mm512_set1_ps(1.0f);
+        const __m512 rampOffsets = _mm512_setr_ps(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f,
+                                                  9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f);
+        float *outputs[2] = {outLeft, outRight};
+
+        // Copies of the runs that wrap, silence for the combs beyond
+        // numCombs and somewhere for their output to go
+        alignas(64) float copies[2][lanesPerChannel][maxRun] = {};
+        alignas(64) float silence[maxRun] = {};
+        alignas(64) float discard[maxRun];
+
+        // Each sample's taps, then its new samples: left combs, then right
+        alignas(64) float lanes[maxRun][2 * lanesPerChannel];
+        alignas(64) float sums[maxRun];
+
+        __m512 last = _mm512_load_ps(&bank.last[0][0]);
+
+        // Same gains on both halves
+        float gains[lanesPerChannel];
+        std::copy(ramps.gains, ramps.gains + numCombs, gains);
+
+        // Left channel's values in the low half, right channel's in the high
+        __m512 damp = _mm512_mask_blend_ps(rightLanes, _mm512_set1_ps(ramps.damp[0]), _mm512_set1_ps(ramps.damp[1]));
+        __m512 feedback = _mm512_mask_blend_ps(rightLanes, _mm512_set1_ps(ramps.feedback[0]),
+                                               _mm512_set1_ps(ramps.feedback[1]));
+        const __m512 dampStep = _mm512_mask_blend_ps(rightLanes, _mm512_set1_ps(ramps.dampStep[0]),
+                                                     _mm512_set1_ps(ramps.dampStep[1]));
+        const __m512 feedbackStep = _mm512_mask_blend_ps(rightLanes, _mm512_set1_ps(ramps.feedbackStep[0]),
+                                                         _mm512_set1_ps(ramps.feedbackStep[1]));
+
+        for (int offset = 0, numThisTime = 0; offset < numSamples; offset += numThisTime)
+        {
+            numThisTime = juce::jmin(bank.getRunLength(0, numCombs, numSamples - offset),
+                                     bank.getRunLength(1, numCombs, numSamples - offset));
+
+            const bool wholeRegisters = numThisTime % 8 == 0;
+            const float *taps[2][lanesPerChannel];
+            float *writes[2][lanesPerChannel];
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int j = 0; j < lanesPerChannel; ++j)
+                {
+                    const int index = bank.indices[channel][j];
+
+                    if (j >= numCombs)
+                    {
+                        taps[channel][j] = silence;
+                        writes[channel][j] = discard;
+                    }
+                    else if (wholeRegisters && index + maxRun <= bank.sizes[channel][j])
+                    {
+                        taps[channel][j] = bank.buffers[channel][j] + index;
+                        writes[channel][j] = bank.buffers[channel][j] + index;
+                    }
+                    else
+                    {
+                        bank.readRun(channel, j, copies[channel][j], numThisTime);
+                        taps[channel][j] = copies[channel][j];
+                        writes[channel][j] = copies[channel][j];
+                    }
+                }
+
+                for (int i = 0; i < numThisTime; i += 16)
+                {
+                    const __m512 position = _mm512_add_ps(rampOffsets, _mm512_set1_ps(static_cast<float>(i)));
+                    __m512 sum = _mm512_setzero_ps();
+
+                    for (int j = 0; j < numCombs; ++j)
+                    {
+                        const __m512 gain = _mm512_fmadd_ps(position, _mm512_set1_ps(ramps.gainSteps[j]),
+                                                            _mm512_set1_ps(gains[j]));
+                        sum = _mm512_fmadd_ps(_mm512_loadu_ps(taps[channel][j] + i), gain, sum);
+                    }
+
+                    float *output = outputs[channel] + offset + i;
+                    if (i + 16 <= numThisTime)
+                    {
+                        _mm512_storeu_ps(output, sum);
+                    }
+                    else
+                    {
+                        _mm512_store_ps(sums, sum);
+                        std::copy(sums, sums + numThisTime - i, output);
+                    }
+                }
+
+                for (int i = 0; i < numThisTime; i += 8)
+                {
+                    const float *sources[8];
+                    float *destinations[8];
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        sources[k] = taps[channel][k] + i;
+                        destinations[k] = lanes[i + k] + channel * lanesPerChannel;
+                    }
+                    transpose8x8(sources, destinations);
+                }
+            }
+
+            for (int j = 0; j < numCombs; ++j)
+                gains[j] += ramps.gainSteps[j] * static_cast<float>(numThisTime);
+
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                damp = _mm512_add_ps(damp, dampStep);
+                feedback = _mm512_add_ps(feedback, feedbackStep);
+
+                const __m512 tap = _mm512_load_ps(lanes[i]);
+                const __m512 input = _mm512_mask_blend_ps(rightLanes, _mm512_set1_ps(inLeft[offset + i]),
+                                                          _mm512_set1_ps(inRight[offset + i]));
+
+                last = _mm512_fmadd_ps(last, damp, _mm512_mul_ps(tap, _mm512_sub_ps(one, damp)));
+                last = _mm512_sub_ps(_mm512_add_ps(last, denormalOffset), denormalOffset);
+
+                __m512 write = _mm512_fmadd_ps(last, feedback, input);
+                write = _mm512_sub_ps(_mm512_add_ps(write, denormalOffset), denormalOffset);
+                _mm512_store_ps(lanes[i], write);
+            }
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int i = 0; i < numThisTime; i += 8)
+                {
+                    const float *sources[8];
+                    float *destinations[8];
+                    for (int k = 0; k < 8; ++k)
+                    {
+                        sources[k] = lanes[i + k] + channel * lanesPerChannel;
+                        destinations[k] = writes[channel][k] + i;
+                    }
+                    transpose8x8(sources, destinations);
+                }
+
+                for (int j = 0; j < numCombs; ++j)
+                {
+                    if (writes[channel][j] == copies[channel][j])
+                    {
+                        bank.writeRun(channel, j, copies[channel][j], numThisTime);
+                    }
+                    else
+                    {
+                        int &index = bank.indices[channel][j];
+                        index += numThisTime;
+                        if (index >= bank.sizes[channel][j])
+                            index = 0;
+                    }
+                }
+            }
+        }
+
+        _mm512_store_ps(&bank.last[0][0], last);
+    }
+
+    RUPTURE_TARGET("avx512f")
+    void firAccumulateAvx512(float *output, const float *input, const float *coefficients,
+                             int numTaps, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            __m512 sum = _mm512_loadu_ps(output + i);
+            for (int j = 0; j < numTaps; ++j)
+                sum = _mm512_fmadd_ps(_mm512_set1_ps(coefficients[j]), _mm512_loadu_ps(input + i - j), sum);
+            _mm512_storeu_ps(output + i, sum);
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            float sum = output[i];
+            for (int j = 0; j < numTaps; ++j)
+                sum += coefficients[j] * input[i - j];
+            output[i] = sum;
+        }
+    }
+
+    RUPTURE_TARGET("avx512f")
+    float sumOfSquaresAvx512(const float *input, int numSamples)
+    {
+        __m512 sum = _mm512_setzero_ps();
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            const __m512 x = _mm512_loadu_ps(input + i);
+            sum = _mm512_fmadd_ps(x, x, sum);
+        }
+
+        float total = _mm512_reduce_add_ps(sum);
+        for (; i < numSamples; ++i)
+            total += input[i] * input[i];
+
+        return total;
+    }
+
+    // A stereo pair only fills half of a 128-bit register, so wider vectors
+    // don't help here; this is the AVX2 loop built for this table
+    RUPTURE_TARGET("avx512f,fma")
+    void biquadCascadeAvx512(StereoBiquadCascade &cascade, float *left, float *right, int numSamples)
+    {
+        for (int stage = 0; stage < StereoBiquadCascade::maxStages; ++stage)
+        {
+            if (!cascade.active[stage])
+                continue;
+
+            const auto &c = cascade.coefficients[stage];
+            const __m128 b0 = _mm_set1_ps(c.b0);
+            const __m128 b12 = _mm_setr_ps(c.b1, c.b1, c.b2, c.b2);
+            const __m128 a12 = _mm_setr_ps(c.a1, c.a1, c.a2, c.a2);
+            __m128 state = _mm_load_ps(cascade.state[stage]);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const __m128 pair = _mm_unpacklo_ps(_mm_load_ss(left + i), _mm_load_ss(right + i));
+                const __m128 x = _mm_movelh_ps(pair, pair);
+
+                const __m128 y = _mm_fmadd_ps(b0, x, state);
+                const __m128 yy = _mm_movelh_ps(y, y);
+
+                const __m128 carried = _mm_movehl_ps(_mm_setzero_ps(), state);
+                state = _mm_fnmadd_ps(a12, yy, _mm_fmadd_ps(b12, x, carried));
+
+                _mm_store_ss(left + i, y);
+                _mm_store_ss(right + i, _mm_shuffle_ps(y, y, 1));
+            }
+
+            _mm_store_ps(cascade.state[stage], state);
+        }
+    }
+}
+
+const DspKernels *DspKernels::getAvx512Kernels()
+{
+    static const DspKernels kernels{Isa::avx512, combBankAvx512, firAccumulateAvx512, sumOfSquaresAvx512,
+                                    biquadCascadeAvx512};
+    return &kernels;
+}
+
+#else
+
+const DspKernels *DspKernels::getAvx512Kernels()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,317 @@
+#include "DspKernels.h"
+
+#if JUCE_INTEL
+
+#include <emmintrin.h>
+
+namespace
+{
+    RUPTURE_TARGET("sse2")
+    inline float horizontalSum(__m128 v)
+    {
+        const __m128 high = _mm_movehl_ps(v, v);
+        const __m128 pairs = _mm_add_ps(v, high);
+        return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+    }
+
+    // Transposes a 4x4 block: row k of the source becomes lane k of each
+    // destination row
+    RUPTURE_TARGET("sse2")
+    inline void transpose4x4(const float *const *sources, float *const *destinations)
+    {
+        __m128 r0 = _mm_loadu_ps(sources[0]);
+        __m128 r1 = _mm_loadu_ps(sources[1]);
+        __m128 r2 = _mm_loadu_ps(sources[2]);
+        __m128 r3 = _mm_loadu_ps(sources[3]);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(destinations[0], r0);
+        _mm_storeu_ps(destinations[1], r1);
+        _mm_storeu_ps(destinations[2], r2);
+        _mm_storeu_ps(destinations[3], r3);
+    }
+
+    // Four combs per register, up to two registers per channel, both
+    // channels through the filters together; the second register is only
+    // run with more than four combs. Each run's taps are summed across combs
+    // a register of samples at a time and transposed to one sample per
+    // register pair for the filters; the new samples are transposed back
+    // into the delay lines. Runs that don't wrap work on the delay lines in
+    // place.
+    RUPTURE_TARGET("sse2")
+    void combBankSse2(CombBankState &bank, int numCombs, const CombBankRamps &ramps,
+                      const float *inLeft, const float *inRight,
+                      float *outLeft, float *outRight, int numSamples)
+    {
+        constexpr int maxCombs = CombBankState::maxCombs;
+        constexpr int maxRun = CombBankState::maxRun;
+        const float *inputs[2] = {inLeft, inRight};
+        float *outputs[2] = {outLeft, outRight};
+        const __m128 denormalOffset = _mm_set1_ps(0.1f);
+        const __m128 rampOffsets = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+        const int numGroups = (numCombs + 3) / 4;
+
+        // Copies of the runs that wrap, silence for the combs beyond
+        // numCombs and somewhere for their output to go
+        alignas(16) float copies[2][maxCombs][maxRun] = {};
+        alignas(16) float silence[maxRun] = {};
+        alignas(16) float discard[maxRun];
+
+        // Each sample's taps, then its new samples: left combs, then right
+        alignas(16) float lanes[maxRun][2 * maxCombs];
+        alignas(16) float sums[maxRun];
+
+        // Per-sample damping and feedback
+        alignas(16) float damps[2][maxRun], undamped[2][maxRun], feedbacks[2][maxRun];
+
+        __m128 last[2][2] = {{_mm_load_ps(bank.last[0]), _mm_load_ps(bank.last[0] + 4)},
+                             {_mm_load_ps(bank.last[1]), _mm_load_ps(bank.last[1] + 4)}};
+        float damp[2] = {ramps.damp[0], ramps.damp[1]};
+        float feedback[2] = {ramps.feedback[0], ramps.feedback[1]};
+        float gains[maxCombs];
+        std::copy(ramps.gains, ramps.gains + numCombs, gains);
+
+        for (int offset = 0, numThisTime = 0; offset < numSamples; offset += numThisTime)
+        {
+            numThisTime = juce::jmin(bank.getRunLength(0, numCombs, numSamples - offset),
+                                     bank.getRunLength(1, numCombs, numSamples - offset));
+
+            const bool wholeRegisters = numThisTime % 4 == 0;
+            const float *taps[2][maxCombs];
+            float *writes[2][maxCombs];
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int j = 0; j < maxCombs; ++j)
+                {
+                    const int index = bank.indices[channel][j];
+
+                    if (j >= numCombs)
+                    {
+                        taps[channel][j] = silence;
+                        writes[channel][j] = discard;
+                    }
+                    else if (wholeRegisters && index + maxRun <= bank.sizes[channel][j])
+                    {
+                        taps[channel][j] = bank.buffers[channel][j] + index;
+                        writes[channel][j] = bank.buffers[channel][j] + index;
+                    }
+                    else
+                    {
+                        bank.readRun(channel, j, copies[channel][j], numThisTime);
+                        taps[channel][j] = copies[channel][j];
+                        writes[channel][j] = copies[channel][j];
+                    }
+                }
+
+                for (int i = 0; i < numThisTime; i += 4)
+                {
+                    const __m128 position = _mm_add_ps(rampOffsets, _mm_set1_ps(static_cast<float>(i)));
+                    __m128 sum = _mm_setzero_ps();
+
+                    for (int j = 0; j < numCombs; ++j)
+                    {
+                        const __m128 gain = _mm_add_ps(_mm_set1_ps(gains[j]),
+                                                       _mm_mul_ps(position, _mm_set1_ps(ramps.gainSteps[j])));
+                        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(taps[channel][j] + i), gain));
+                    }
+
+                    float *output = outputs[channel] + offset + i;
+                    if (i + 4 <= numThisTime)
+                    {
+                        _mm_storeu_ps(output, sum);
+                    }
+                    else
+                    {
+                        _mm_store_ps(sums, sum);
+                        std::copy(sums, sums + numThisTime - i, output);
+                    }
+                }
+
+                for (int i = 0; i < numThisTime; i += 4)
+                {
+                    for (int g = 0; g < 4 * numGroups; g += 4)
+                    {
+                        const float *sources[4];
+                        float *destinations[4];
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            sources[k] = taps[channel][g + k] + i;
+                            destinations[k] = lanes[i + k] + channel * maxCombs + g;
+                        }
+                        transpose4x4(sources, destinations);
+                    }
+                }
+
+                for (int i = 0; i < numThisTime; ++i)
+                {
+                    damp[channel] += ramps.dampStep[channel];
+                    feedback[channel] += ramps.feedbackStep[channel];
+                    damps[channel][i] = damp[channel];
+                    undamped[channel][i] = 1.0f - damp[channel];
+                    feedbacks[channel][i] = feedback[channel];
+                }
+            }
+
+            for (int j = 0; j < numCombs; ++j)
+                gains[j] += ramps.gainSteps[j] * static_cast<float>(numThisTime);
+
+            for (int i = 0; i < numThisTime; ++i)
+            {
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    const __m128 vDamp = _mm_load1_ps(&damps[channel][i]);
+                    const __m128 vUndamped = _mm_load1_ps(&undamped[channel][i]);
+                    const __m128 vFeedback = _mm_load1_ps(&feedbacks[channel][i]);
+                    const __m128 vInput = _mm_load1_ps(inputs[channel] + offset + i);
+
+                    for (int g = 0; g < numGroups; ++g)
+                    {
+                        float *lane = lanes[i] + channel * maxCombs + 4 * g;
+                        const __m128 tap = _mm_load_ps(lane);
+
+                        __m128 l = _mm_add_ps(_mm_mul_ps(tap, vUndamped), _mm_mul_ps(last[channel][g], vDamp));
+                        l = _mm_sub_ps(_mm_add_ps(l, denormalOffset), denormalOffset);
+                        last[channel][g] = l;
+
+                        __m128 write = _mm_add_ps(vInput, _mm_mul_ps(l, vFeedback));
+                        write = _mm_sub_ps(_mm_add_ps(write, denormalOffset), denormalOffset);
+                        _mm_store_ps(lane, write);
+                    }
+                }
+            }
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int i = 0; i < numThisTime; i += 4)
+                {
+                    for (int g = 0; g < 4 * numGroups; g += 4)
+                    {
+                        const float *sources[4];
+                        float *destinations[4];
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            sources[k] = lanes[i + k] + channel * maxCombs + g;
+                            destinations[k] = writes[channel][g + k] + i;
+                        }
+                        transpose4x4(sources, destinations);
+                    }
+                }
+
+                for (int j = 0; j < numCombs; ++j)
+                {
+                    if (writes[channel][j] == copies[channel][j])
+                    {
+                        bank.writeRun(channel, j, copies[channel][j], numThisTime);
+                    }
+                    else
+                    {
+                        int &index = bank.indices[channel][j];
+                        index += numThisTime;
+                        if (index >= bank.sizes[channel][j])
+                            index = 0;
+                    }
+                }
+            }
+        }
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            _mm_store_ps(bank.last[channel], last[channel][0]);
+            _mm_store_ps(bank.last[channel] + 4, last[channel][1]);
+        }
+    }
+
+    RUPTURE_TARGET("sse2")
+    void firAccumulateSse2(float *output, const float *input, const float *coefficients,
+                           int numTaps, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            __m128 sum = _mm_loadu_ps(output + i);
+            for (int j = 0; j < numTaps; ++j)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(coefficients[j]), _mm_loadu_ps(input + i - j)));
+            _mm_storeu_ps(output + i, sum);
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            float sum = output[i];
+            for (int j = 0; j < numTaps; ++j)
+                sum += coefficients[j] * input[i - j];
+            output[i] = sum;
+        }
+    }
+
+    RUPTURE_TARGET("sse2")
+    float sumOfSquaresSse2(const float *input, int numSamples)
+    {
+        __m128 sum = _mm_setzero_ps();
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const __m128 x = _mm_loadu_ps(input + i);
+            sum = _mm_add_ps(sum, _mm_mul_ps(x, x));
+        }
+
+        float total = horizontalSum(sum);
+        for (; i < numSamples; ++i)
+            total += input[i] * input[i];
+
+        return total;
+    }
+
+    // The stereo pair and both state variables share one register:
+    // state {s1L, s1R, s2L, s2R} is updated from {xL, xR, xL, xR}
+    RUPTURE_TARGET("sse2")
+    void biquadCascadeSse2(StereoBiquadCascade &cascade, float *left, float *right, int numSamples)
+    {
+        for (int stage = 0; stage < StereoBiquadCascade::maxStages; ++stage)
+        {
+            if (!cascade.active[stage])
+                continue;
+
+            const auto &c = cascade.coefficients[stage];
+            const __m128 b0 = _mm_set1_ps(c.b0);
+            const __m128 b12 = _mm_setr_ps(c.b1, c.b1, c.b2, c.b2);
+            const __m128 a12 = _mm_setr_ps(c.a1, c.a1, c.a2, c.a2);
+            __m128 state = _mm_load_ps(cascade.state[stage]);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const __m128 pair = _mm_unpacklo_ps(_mm_load_ss(left + i), _mm_load_ss(right + i));
+                const __m128 x = _mm_movelh_ps(pair, pair);
+
+                const __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), state);
+                const __m128 yy = _mm_movelh_ps(y, y);
+
+                // s1 picks up the old s2, s2 starts from zero
+                const __m128 carried = _mm_movehl_ps(_mm_setzero_ps(), state);
+                state = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b12, x), _mm_mul_ps(a12, yy)), carried);
+
+                _mm_store_ss(left + i, y);
+                _mm_store_ss(right + i, _mm_shuffle_ps(y, y, 1));
+            }
+
+            _mm_store_ps(cascade.state[stage], state);
+        }
+    }
+}
+
+const DspKernels *DspKernels::getSse2Kernels()
+{
+    static const DspKernels kernels{Isa::sse2, combBankSse2, firAccumulateSse2, sumOfSquaresSse2,
+                                    biquadCascadeSse2};
+    return &kernels;
+}
+
+#else
+
+const DspKernels *DspKernels::getSse2Kernels()
+{
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include "DspKernels.h"
+
+// Reference implementations. These define the expected output of every
+// other variant and are used on CPUs without a supported vector unit.
+namespace
+{
+    void combBankScalar(CombBankState &bank, int numCombs, const CombBankRamps &ramps,
+                        const float *inLeft, const float *inRight,
+                        float *outLeft, float *outRight, int numSamples)
+    {
+        const float *inputs[2] = {inLeft, inRight};
+        float *outputs[2] = {outLeft, outRight};
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const float *input = inputs[channel];
+            float damp = ramps.damp[channel];
+            float feedback = ramps.feedback[channel];
+            float gains[CombBankState::maxCombs];
+            std::copy(ramps.gains, ramps.gains + numCombs, gains);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                damp += ramps.dampStep[channel];
+                feedback += ramps.feedbackStep[channel];
+                float sum = 0.0f;
+
+                for (int j = 0; j < numCombs; ++j)
+                {
+                    float *buffer = bank.buffers[channel][j];
+                    int &index = bank.indices[channel][j];
+                    float &last = bank.last[channel][j];
+
+                    const float output = buffer[index];
+                    last = (output * (1.0f - damp)) + (last * damp);
+                    JUCE_UNDENORMALISE(last);
+
+                    float temp = input[i] + (last * feedback);
+                    JUCE_UNDENORMALISE(temp);
+                    buffer[index] = temp;
+                    if (++index >= bank.sizes[channel][j])
+                        index = 0;
+
+                    gains[j] += ramps.gainSteps[j];
+                    sum += output * gains[j];
+                }
+
+                outputs[channel][i] = sum;
+            }
+        }
+    }
+
+    void firAccumulateScalar(float *output, const float *input, const float *coefficients,
+                             int numTaps, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float sum = output[i];
+            for (int j = 0; j < numTaps; ++j)
+                sum += coefficients[j] * input[i - j];
+            output[i] = sum;
+        }
+    }
+
+    float sumOfSquaresScalar(const float *input, int numSamples)
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            sum += input[i] * input[i];
+        return sum;
+    }
+
+    void biquadCascadeScalar(StereoBiquadCascade &cascade, float *left, float *right, int numSamples)
+    {
+        for (int stage = 0; stage < StereoBiquadCascade::maxStages; ++stage)
+        {
+            if (!cascade.active[stage])
+                continue;
+
+            const auto &c = cascade.coefficients[stage];
+            float *state = cascade.state[stage];
+            float *channels[2] = {left, right};
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                float s1 = state[channel];
+                float s2 = state[2 + channel];
+                float *data = channels[channel];
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const float x = data[i];
+                    const float y = c.b0 * x + s1;
+                    s1 = c.b1 * x - c.a1 * y + s2;
+                    s2 = c.b2 * x - c.a2 * y;
+                    data[i] = y;
+                }
+
+                state[channel] = s1;
+                state[2 + channel] = s2;
+            }
+        }
+    }
+}
+
+const DspKernels *DspKernels::getScalarKernels()
+{
+    static const DspKernels kernels{Isa::scalar, combBankScalar, firAccumulateScalar, sumOfSquaresScalar,
+                                    biquadCascadeScalar};
+    return &kernels;
+}
@@ -0,0 +1,807 @@
+// DSP regression suite.
+//
+// Renders a fixed stimulus through ReverbProcessor in one scenario per
+// engine path, with every kernel variant the CPU supports and over fixed
+// and random host block patterns, and null-tests each render against the
+// scenario's golden file. Each kernel is also checked against a double
+// precision reference of the scalar code. With --perf it instead times
+// every scenario with every supported variant and fails if the kernels
+// dispatch picks by default are slower than the scalar ones. Given a
+// --baseline it also fails if ns/sample regresses past that file, which
+// only means something on the machine that recorded it.
+//
+//   RuptureTests --data=src/tests [--regenerate]
+//   RuptureTests --perf [--tolerance=0.15] [--baseline=perf.txt [--regenerate]]
+//
+// --regenerate rewrites the golden files from the scalar kernels, or with
+// --perf the baseline; only do the former for an intended change in sound.
+
+#include <JuceHeader.h>
+#include "ReverbProcessor.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int maxBlockSize = 2048;
+
+    // Golden renders: a quarter of a second, rendered in 512-sample blocks
+    constexpr int numFrames = 12000;
+    constexpr int goldenBlockSize = 512;
+
+    // Largest difference from the golden, relative to full scale, that a
+    // render may show; vector kernels reorder sums and fuse multiply-adds,
+    // and the saturator and tone filter step their controls once per call
+    constexpr float goldenToleranceDb = -80.0f;
+
+    // Largest difference between a kernel and its double reference,
+    // relative to the reference's peak
+    constexpr double kernelTolerance = 1.0e-5;
+
+    // Performance: the best of several two-second renders, which may take
+    // this much longer than the scalar kernels or the baseline
+    constexpr int perfFrames = 96000;
+    constexpr int perfBlockSize = 512;
+    constexpr int perfRuns = 5;
+    constexpr double defaultPerfTolerance = 0.15;
+
+    // Tells CTest the test was skipped
+    constexpr int skipReturnCode = 77;
+
+    const DspKernels::Isa allIsas[] = {DspKernels::Isa::scalar, DspKernels::Isa::sse2,
+                                       DspKernels::Isa::avx2, DspKernels::Isa::avx512};
+
+    //==============================================================================
+    // Stimulus and scenarios
+
+    // Fixed noise, so the stimulus never moves with juce::Random's sequence
+    class Noise
+    {
+    public:
+        explicit Noise(uint32_t seed) : state(seed) {}
+
+        // -1.0 - 1.0
+        float next()
+        {
+            state = state * 1664525u + 1013904223u;
+            return static_cast<float>(static_cast<int32_t>(state)) / 2147483648.0f;
+        }
+
+    private:
+        uint32_t state;
+    };
+
+    // An impulse and a decaying noise burst, silence, a sine burst and
+    // silence again, so the gate and ducker open and close in every golden
+    // render. Longer stimuli repeat the pattern.
+    juce::AudioBuffer<float> makeStimulus(int frames)
+    {
+        const int burstEnd = juce::roundToInt(0.04 * sampleRate);
+        const int toneStart = juce::roundToInt(0.12 * sampleRate);
+        const int toneEnd = juce::roundToInt(0.2 * sampleRate);
+        const float fadeLength = static_cast<float>(0.005 * sampleRate);
+
+        juce::AudioBuffer<float> stimulus(2, frames);
+        stimulus.clear();
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            Noise noise(static_cast<uint32_t>(channel + 1));
+            const double frequency = channel == 0 ? 220.0 : 330.0;
+            float *data = stimulus.getWritePointer(channel);
+
+            for (int i = 0; i < frames; ++i)
+            {
+                const int position = i % numFrames;
+
+                if (position == 0)
+                    data[i] = 0.9f;
+                else if (position < burstEnd)
+                    data[i] = 0.5f * noise.next() * std::exp(-8.0f * static_cast<float>(position) / static_cast<float>(burstEnd));
+                else if (position >= toneStart && position < toneEnd)
+                {
+                    const float fade = juce::jmin(1.0f, static_cast<float>(position - toneStart) / fadeLength,
+                                                  static_cast<float>(toneEnd - position) / fadeLength);
+                    data[i] = 0.3f * fade * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * frequency * position / sampleRate));
+                }
+            }
+        }
+
+        return stimulus;
+    }
+
+    struct ParameterChange
+    {
+        int frame;
+        std::function<void(ReverbProcessor &)> apply;
+    };
+
+    struct Scenario
+    {
+        const char *name;
+
+        // Applied before prepare(), like a restored state
+        std::function<void(ReverbProcessor &)> setUp;
+
+        // Applied on their exact frame under every block pattern
+        std::vector<ParameterChange> changes;
+    };
+
+    ParameterChange renderTierAt(int frame, ReverbTank::QualityTier tier)
+    {
+        return {frame, [tier](ReverbProcessor &processor) { processor.setRenderTier(tier); }};
+    }
+
+    // One scenario per engine path, each golden file named after it
+    std::vector<Scenario> makeScenarios()
+    {
+        const int changeFrame = juce::roundToInt(0.1 * sampleRate);
+        const auto defaults = [](ReverbProcessor &) {};
+
+        return {
+            {"default", defaults, {}},
+            {"eco", defaults, {renderTierAt(0, ReverbTank::QualityTier::eco)}},
+            {"normal", defaults, {renderTierAt(0, ReverbTank::QualityTier::normal)}},
+            {"tier_switch", defaults, {renderTierAt(changeFrame, ReverbTank::QualityTier::eco)}},
+            {"half_rate", [](ReverbProcessor &p) { p.setHalfRateTail(true); }, {}},
+            {"tone", [](ReverbProcessor &p)
+             {
+                 p.setLowCut(0.3f);
+                 p.setHighCut(0.6f);
+                 p.setTilt(0.7f);
+             },
+             {}},
+            {"shimmer", [](ReverbProcessor &p) { p.setShimmerAmount(0.5f); }, {}},
+            {"drive", [](ReverbProcessor &p)
+             {
+                 p.setShimmerAmount(0.5f);
+                 p.setShimmerPitch(0.0f);
+                 p.setDrive(0.6f);
+             },
+             {}},
+            {"shimmer_drive", [](ReverbProcessor &p)
+             {
+                 p.setShimmerAmount(0.4f);
+                 p.setShimmerPitch(-12.0f);
+                 p.setDrive(0.5f);
+                 p.setDriveOversampling(4);
+             },
+             {}},
+            {"reverse", [](ReverbProcessor &p)
+             {
+                 p.setTailMode(ReverbProcessor::TailMode::reverse);
+                 p.setReverseLength(0.0f);
+             },
+             {}},
+            {"gated", [](ReverbProcessor &p)
+             {
+                 p.setTailMode(ReverbProcessor::TailMode::gated);
+                 p.setGateHold(0.0f);
+             },
+             {}},
+            {"duck", [](ReverbProcessor &p)
+             {
+                 p.setDuckAmount(0.8f);
+                 p.setDuckThreshold(0.3f);
+                 p.setDuckRelease(0.0f);
+             },
+             {}},
+            {"freeze", defaults, {{changeFrame, [](ReverbProcessor &p) { p.setFreezeMode(1.0f); }}}},
+            {"capture_freeze", defaults,
+             {{changeFrame, [](ReverbProcessor &p)
+               {
+                   p.setCaptureFreeze(true);
+                   p.setFreezeMode(1.0f);
+               }}}},
+            {"mid_side", [](ReverbProcessor &p)
+             {
+                 p.setMidSideMode(true);
+                 p.setSideRoomSize(0.8f);
+                 p.setSideDamping(0.2f);
+                 p.setMidLevel(0.8f);
+             },
+             {}},
+            {"automation", defaults,
+             {{changeFrame, [](ReverbProcessor &p)
+               {
+                   p.setRoomSize(0.9f);
+                   p.setDamping(0.1f);
+                   p.setWidth(0.3f);
+                   p.setWetLevel(0.8f);
+               }}}},
+        };
+    }
+
+    //==============================================================================
+    // Rendering
+
+    // Host block sizes, cycled through for the length of a render
+    struct BlockPattern
+    {
+        juce::String name;
+        std::vector<int> sizes;
+    };
+
+    std::vector<BlockPattern> makeBlockPatterns()
+    {
+        std::vector<BlockPattern> patterns;
+
+        for (int size : {1, 17, 64, goldenBlockSize, maxBlockSize})
+            patterns.push_back({"fixed " + juce::String(size), {size}});
+
+        // Random sizes spread over every power of two up to the maximum
+        juce::Random random(0x5eed);
+        BlockPattern randomSizes{"random", {}};
+        for (int i = 0; i < 256; ++i)
+            randomSizes.sizes.push_back(1 + random.nextInt(juce::jmin(maxBlockSize, 1 << random.nextInt(12))));
+        patterns.push_back(randomSizes);
+
+        return patterns;
+    }
+
+    // Renders the stimulus through a fresh processor. Blocks end early at
+    // each parameter change so it lands on the same frame under any pattern.
+    // Time spent in processBlock is added to processSeconds when given.
+    juce::AudioBuffer<float> render(const Scenario &scenario, const juce::AudioBuffer<float> &stimulus,
+                                    const BlockPattern &pattern, double *processSeconds = nullptr)
+    {
+        ReverbProcessor processor;
+        scenario.setUp(processor);
+        processor.prepare(sampleRate, maxBlockSize);
+
+        const int frames = stimulus.getNumSamples();
+        juce::AudioBuffer<float> output(2, frames);
+        juce::AudioBuffer<float> block(2, maxBlockSize);
+
+        size_t nextChange = 0;
+        size_t nextSize = 0;
+
+        for (int position = 0; position < frames;)
+        {
+            while (nextChange < scenario.changes.size() && scenario.changes[nextChange].frame <= position)
+                scenario.changes[nextChange++].apply(processor);
+
+            int numSamples = juce::jmin(pattern.sizes[nextSize++ % pattern.sizes.size()], frames - position);
+            if (nextChange < scenario.changes.size())
+                numSamples = juce::jmin(numSamples, scenario.changes[nextChange].frame - position);
+
+            block.setSize(2, numSamples, false, false, true);
+            for (int channel = 0; channel < 2; ++channel)
+                juce::FloatVectorOperations::copy(block.getWritePointer(channel), stimulus.getReadPointer(channel, position), numSamples);
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            processor.processBlock(block);
+            if (processSeconds != nullptr)
+                *processSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+
+            for (int channel = 0; channel < 2; ++channel)
+                juce::FloatVectorOperations::copy(output.getWritePointer(channel, position), block.getReadPointer(channel), numSamples);
+
+            position += numSamples;
+        }
+
+        return output;
+    }
+
+    // Largest sample difference between two renders, in dB relative to full scale
+    float getResidualDecibels(const juce::AudioBuffer<float> &render, const juce::AudioBuffer<float> &golden)
+    {
+        float worst = 0.0f;
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            const float *a = render.getReadPointer(channel);
+            const float *b = golden.getReadPointer(channel);
+
+            for (int i = 0; i < golden.getNumSamples(); ++i)
+            {
+                // A NaN anywhere must fail the comparison
+                const float difference = std::abs(a[i] - b[i]);
+                worst = difference == difference ? juce::jmax(worst, difference) : 1.0e9f;
+            }
+        }
+
+        return juce::Decibels::gainToDecibels(worst, -200.0f);
+    }
+
+    // Golden renders are raw little-endian float32, the left channel then
+    // the right; every target the plugin ships on is little-endian
+    juce::File getGoldenFile(const juce::File &dataDirectory, const Scenario &scenario)
+    {
+        return dataDirectory.getChildFile("golden").getChildFile(juce::String(scenario.name) + ".f32");
+    }
+
+    bool loadGolden(const juce::File &file, juce::AudioBuffer<float> &golden)
+    {
+        juce::MemoryBlock data;
+        if (!file.loadFileAsData(data) || data.getSize() != sizeof(float) * 2 * numFrames)
+            return false;
+
+        const float *samples = static_cast<const float *>(data.getData());
+        golden.setSize(2, numFrames);
+        juce::FloatVectorOperations::copy(golden.getWritePointer(0), samples, numFrames);
+        juce::FloatVectorOperations::copy(golden.getWritePointer(1), samples + numFrames, numFrames);
+        return true;
+    }
+
+    bool saveGolden(const juce::File &file, const juce::AudioBuffer<float> &golden)
+    {
+        juce::MemoryBlock data(sizeof(float) * 2 * numFrames);
+        float *samples = static_cast<float *>(data.getData());
+        juce::FloatVectorOperations::copy(samples, golden.getReadPointer(0), numFrames);
+        juce::FloatVectorOperations::copy(samples + numFrames, golden.getReadPointer(1), numFrames);
+
+        return file.getParentDirectory().createDirectory() && file.replaceWithData(data.getData(), data.getSize());
+    }
+
+    //==============================================================================
+    // Kernels against double-precision references of the scalar code
+
+    // Worst difference relative to the reference's peak
+    double getRelativeError(const std::vector<float> &result, const std::vector<double> &reference)
+    {
+        double peak = 0.0, worst = 0.0;
+
+        for (size_t i = 0; i < reference.size(); ++i)
+        {
+            peak = juce::jmax(peak, std::abs(reference[i]));
+            const double difference = std::abs(static_cast<double>(result[i]) - reference[i]);
+            worst = difference == difference ? juce::jmax(worst, difference) : 1.0e9;
+        }
+
+        return worst / juce::jmax(peak, 1.0e-30);
+    }
+
+    std::vector<float> makeNoise(uint32_t seed, size_t length)
+    {
+        Noise noise(seed);
+        std::vector<float> samples(length);
+        for (auto &sample : samples)
+            sample = 0.5f * noise.next();
+        return samples;
+    }
+
+    double checkCombBank(const DspKernels &kernels)
+    {
+        // Odd, so the vector kernels' last run ends part way into a register
+        constexpr int blockSize = 251;
+        constexpr int numBlocks = 3;
+        double worst = 0.0;
+
+        for (int numCombs = 1; numCombs <= CombBankState::maxCombs; ++numCombs)
+        {
+            CombBankState bank;
+            std::vector<float> buffers[2][CombBankState::maxCombs];
+            std::vector<double> referenceBuffers[2][CombBankState::maxCombs];
+            int referenceIndices[2][CombBankState::maxCombs] = {};
+            double referenceLast[2][CombBankState::maxCombs] = {};
+
+            for (int channel = 0; channel < 2; ++channel)
+            {
+                for (int j = 0; j < numCombs; ++j)
+                {
+                    // Shorter than a block, so every comb wraps within one
+                    const int size = 97 + 23 * j + 11 * channel;
+                    buffers[channel][j].assign(static_cast<size_t>(size), 0.0f);
+                    referenceBuffers[channel][j].assign(static_cast<size_t>(size), 0.0);
+                    bank.buffers[channel][j] = buffers[channel][j].data();
+                    bank.sizes[channel][j] = size;
+                }
+            }
+
+            const auto input = makeNoise(static_cast<uint32_t>(numCombs), blockSize * numBlocks * 2);
+            std::vector<float> output(blockSize * numBlocks * 2);
+            std::vector<double> reference(output.size());
+
+            for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+            {
+                // Every value ramps, and the two channels are tuned apart
+                CombBankRamps ramps;
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    ramps.damp[channel] = 0.2f + 0.1f * channel + 0.05f * blockIndex;
+                    ramps.dampStep[channel] = 1.0e-4f;
+                    ramps.feedback[channel] = 0.8f + 0.02f * channel;
+                    ramps.feedbackStep[channel] = -5.0e-5f;
+                }
+                for (int j = 0; j < numCombs; ++j)
+                {
+                    ramps.gains[j] = 0.5f + 0.05f * j;
+                    ramps.gainSteps[j] = (j % 2 == 0 ? 1.0f : -1.0f) * 1.0e-4f;
+                }
+
+                const size_t offset = static_cast<size_t>(blockIndex * blockSize * 2);
+                const float *inLeft = input.data() + offset;
+                const float *inRight = inLeft + blockSize;
+                kernels.combBank(bank, numCombs, ramps, inLeft, inRight,
+                                 output.data() + offset, output.data() + offset + blockSize, blockSize);
+
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    const float *in = channel == 0 ? inLeft : inRight;
+                    double *out = reference.data() + offset + static_cast<size_t>(channel * blockSize);
+                    double damp = ramps.damp[channel];
+                    double feedback = ramps.feedback[channel];
+                    double gains[CombBankState::maxCombs];
+                    std::copy(ramps.gains, ramps.gains + numCombs, gains);
+
+                    for (int i = 0; i < blockSize; ++i)
+                    {
+                        damp += ramps.dampStep[channel];
+                        feedback += ramps.feedbackStep[channel];
+                        double sum = 0.0;
+
+                        for (int j = 0; j < numCombs; ++j)
+                        {
+                            auto &buffer = referenceBuffers[channel][j];
+                            int &index = referenceIndices[channel][j];
+                            double &last = referenceLast[channel][j];
+
+                            const double combOutput = buffer[static_cast<size_t>(index)];
+                            last = combOutput * (1.0 - damp) + last * damp;
+                            buffer[static_cast<size_t>(index)] = in[i] + last * feedback;
+                            if (++index >= bank.sizes[channel][j])
+                                index = 0;
+
+                            gains[j] += ramps.gainSteps[j];
+                            sum += combOutput * gains[j];
+                        }
+
+                        out[i] = sum;
+                    }
+                }
+            }
+
+            worst = juce::jmax(worst, getRelativeError(output, reference));
+        }
+
+        return worst;
+    }
+
+    double checkFirAccumulate(const DspKernels &kernels)
+    {
+        double worst = 0.0;
+
+        for (int numTaps : {1, 7, 16, 31, 48})
+        {
+            for (int numSamples : {1, 13, 64, 200})
+            {
+                // The input pointer is preceded by numTaps - 1 samples of history
+                const auto history = makeNoise(static_cast<uint32_t>(numTaps * 1000 + numSamples),
+                                               static_cast<size_t>(numTaps - 1 + numSamples));
+                const auto coefficients = makeNoise(static_cast<uint32_t>(numTaps), static_cast<size_t>(numTaps));
+                const float *input = history.data() + numTaps - 1;
+
+                auto output = makeNoise(static_cast<uint32_t>(numSamples), static_cast<size_t>(numSamples));
+                std::vector<double> reference(output.begin(), output.end());
+
+                kernels.firAccumulate(output.data(), input, coefficients.data(), numTaps, numSamples);
+
+                for (int i = 0; i < numSamples; ++i)
+                    for (int j = 0; j < numTaps; ++j)
+                        reference[static_cast<size_t>(i)] += static_cast<double>(coefficients[static_cast<size_t>(j)]) * input[i - j];
+
+                worst = juce::jmax(worst, getRelativeError(output, reference));
+            }
+        }
+
+        return worst;
+    }
+
+    double checkSumOfSquares(const DspKernels &kernels)
+    {
+        double worst = 0.0;
+
+        for (int numSamples : {1, 7, 16, 63, 64, 100, 512})
+        {
+            const auto input = makeNoise(static_cast<uint32_t>(numSamples), static_cast<size_t>(numSamples));
+
+            double reference = 0.0;
+            for (float sample : input)
+                reference += static_cast<double>(sample) * sample;
+
+            const float result = kernels.sumOfSquares(input.data(), numSamples);
+            worst = juce::jmax(worst, getRelativeError({result}, {reference}));
+        }
+
+        return worst;
+    }
+
+    double checkBiquadCascade(const DspKernels &kernels)
+    {
+        // A low-pass, a high-pass and two shelves, with one left out so
+        // inactive stages are skipped
+        const StereoBiquadCascade::Coefficients designs[StereoBiquadCascade::maxStages] = {
+            {0.0675f, 0.1349f, 0.0675f, -1.1430f, 0.4128f},
+            {0.9565f, -1.9131f, 0.9565f, -1.9112f, 0.9150f},
+            {1.0466f, -1.8038f, 0.7910f, -1.8065f, 0.8349f},
+            {1.1210f, -1.5402f, 0.5870f, -1.4211f, 0.5890f}};
+
+        double worst = 0.0;
+
+        for (int inactiveStage = -1; inactiveStage < StereoBiquadCascade::maxStages; ++inactiveStage)
+        {
+            StereoBiquadCascade cascade;
+            double referenceState[StereoBiquadCascade::maxStages][4] = {};
+
+            for (int stage = 0; stage < StereoBiquadCascade::maxStages; ++stage)
+            {
+                cascade.coefficients[stage] = designs[stage];
+                cascade.active[stage] = stage != inactiveStage;
+            }
+
+            for (int numSamples : {1, 13, 64, 200})
+            {
+                auto left = makeNoise(static_cast<uint32_t>(numSamples), static_cast<size_t>(numSamples));
+                auto right = makeNoise(static_cast<uint32_t>(numSamples + 1), static_cast<size_t>(numSamples));
+                std::vector<double> reference[2] = {{left.begin(), left.end()}, {right.begin(), right.end()}};
+
+                kernels.biquadCascade(cascade, left.data(), right.data(), numSamples);
+
+                for (int stage = 0; stage < StereoBiquadCascade::maxStages; ++stage)
+                {
+                    if (!cascade.active[stage])
+                        continue;
+
+                    const auto &c = designs[stage];
+                    for (int channel = 0; channel < 2; ++channel)
+                    {
+                        double &s1 = referenceState[stage][channel];
+                        double &s2 = referenceState[stage][2 + channel];
+
+                        for (auto &sample : reference[channel])
+                        {
+                            const double x = sample;
+                            const double y = c.b0 * x + s1;
+                            s1 = c.b1 * x - c.a1 * y + s2;
+                            s2 = c.b2 * x - c.a2 * y;
+                            sample = y;
+                        }
+                    }
+                }
+
+                worst = juce::jmax(worst, getRelativeError(left, reference[0]), getRelativeError(right, reference[1]));
+            }
+        }
+
+        return worst;
+    }
+
+    //==============================================================================
+    // Test modes
+
+    bool runKernelTests()
+    {
+        bool passed = true;
+        std::printf("Kernels against double references (tolerance %.0e)\n", kernelTolerance);
+
+        for (auto isa : allIsas)
+        {
+            if (!DspKernels::forceIsa(isa))
+                continue;
+
+            const auto &kernels = DspKernels::get();
+            const double errors[] = {checkCombBank(kernels), checkFirAccumulate(kernels),
+                                     checkSumOfSquares(kernels), checkBiquadCascade(kernels)};
+
+            bool isaPassed = true;
+            for (double error : errors)
+                isaPassed = isaPassed && error <= kernelTolerance;
+
+            std::printf("  %-8s comb %.1e  fir %.1e  squares %.1e  biquad %.1e  %s\n",
+                        DspKernels::getIsaName(isa), errors[0], errors[1], errors[2], errors[3],
+                        isaPassed ? "ok" : "FAILED");
+            passed = passed && isaPassed;
+        }
+
+        return passed;
+    }
+
+    bool runGoldenTests(const juce::File &dataDirectory, bool regenerate)
+    {
+        bool passed = true;
+        const auto stimulus = makeStimulus(numFrames);
+        const auto patterns = makeBlockPatterns();
+        const BlockPattern goldenPattern{"golden", {goldenBlockSize}};
+
+        std::printf("\nRenders against golden files (tolerance %.0f dB)\n", goldenToleranceDb);
+
+        for (const auto &scenario : makeScenarios())
+        {
+            const auto goldenFile = getGoldenFile(dataDirectory, scenario);
+            juce::AudioBuffer<float> golden;
+
+            if (regenerate)
+            {
+                DspKernels::forceIsa(DspKernels::Isa::scalar);
+                golden = render(scenario, stimulus, goldenPattern);
+
+                if (!saveGolden(goldenFile, golden))
+                {
+                    std::printf("  %-15s could not write %s\n", scenario.name, goldenFile.getFullPathName().toRawUTF8());
+                    passed = false;
+                    continue;
+                }
+            }
+            else if (!loadGolden(goldenFile, golden))
+            {
+                std::printf("  %-15s missing or malformed %s\n", scenario.name, goldenFile.getFullPathName().toRawUTF8());
+                passed = false;
+                continue;
+            }
+
+            float worstDecibels = -200.0f;
+            juce::String worstCase = "-";
+
+            for (auto isa : allIsas)
+            {
+                if (!DspKernels::forceIsa(isa))
+                    continue;
+
+                for (const auto &pattern : patterns)
+                {
+                    const float residual = getResidualDecibels(render(scenario, stimulus, pattern), golden);
+                    if (residual > worstDecibels)
+                    {
+                        worstDecibels = residual;
+                        worstCase = juce::String(DspKernels::getIsaName(isa)) + ", " + pattern.name;
+                    }
+                }
+            }
+
+            const bool scenarioPassed = worstDecibels <= goldenToleranceDb;
+            std::printf("  %-15s worst %7.1f dB (%s)  %s\n", scenario.name, worstDecibels,
+                        worstCase.toRawUTF8(), scenarioPassed ? "ok" : "FAILED");
+            passed = passed && scenarioPassed;
+        }
+
+        return passed;
+    }
+
+    // Best ns per stereo frame of every supported ISA over several renders,
+    // timing processBlock only. The ISAs take turns within each run, so a
+    // burst of load on the machine slows them all alike.
+    std::map<DspKernels::Isa, double> measureNanosecondsPerFrame(const Scenario &scenario, const juce::AudioBuffer<float> &stimulus)
+    {
+        const BlockPattern pattern{"perf", {perfBlockSize}};
+        std::map<DspKernels::Isa, double> best;
+
+        for (int run = 0; run < perfRuns; ++run)
+        {
+            for (auto isa : allIsas)
+            {
+                if (!DspKernels::forceIsa(isa))
+                    continue;
+
+                double seconds = 0.0;
+                render(scenario, stimulus, pattern, &seconds);
+
+                const double nanoseconds = seconds * 1.0e9 / stimulus.getNumSamples();
+                const auto entry = best.find(isa);
+                best[isa] = entry == best.end() ? nanoseconds : juce::jmin(entry->second, nanoseconds);
+            }
+        }
+
+        return best;
+    }
+
+    int runPerformanceTests(const juce::File &baselineFile, bool regenerate, double tolerance)
+    {
+#if JUCE_DEBUG
+        juce::ignoreUnused(baselineFile, regenerate, tolerance);
+        std::printf("Performance is only checked in optimised builds; skipped\n");
+        return skipReturnCode;
+#else
+        const bool useBaseline = baselineFile != juce::File();
+
+        if (regenerate && !useBaseline)
+        {
+            std::printf("--regenerate with --perf needs a --baseline to write\n");
+            return 1;
+        }
+
+        // One "scenario isa ns" entry per line; # starts a comment
+        std::map<juce::String, double> baseline;
+        if (useBaseline)
+        {
+            for (const auto &line : juce::StringArray::fromLines(baselineFile.loadFileAsString()))
+            {
+                const auto tokens = juce::StringArray::fromTokens(line.upToFirstOccurrenceOf("#", false, false), false);
+                if (tokens.size() == 3)
+                    baseline[tokens[0] + " " + tokens[1]] = tokens[2].getDoubleValue();
+            }
+
+            if (baseline.empty() && !regenerate)
+            {
+                std::printf("No baseline in %s\n", baselineFile.getFullPathName().toRawUTF8());
+                return 1;
+            }
+        }
+
+        const auto stimulus = makeStimulus(perfFrames);
+        juce::String newBaseline = "# ns per stereo frame: best of " + juce::String(perfRuns) + " renders of " +
+                                   juce::String(perfFrames / sampleRate, 1) + " s at " + juce::String(juce::roundToInt(sampleRate)) +
+                                   " Hz in " + juce::String(perfBlockSize) + "-sample blocks.\n"
+                                   "# Written by RuptureTests --perf --baseline=<this file> --regenerate.\n";
+        bool passed = true;
+
+        const auto defaultIsa = DspKernels::getDefaultIsa();
+        std::printf("Performance of the default %s kernels against scalar (tolerance +%.0f%%)\n",
+                    DspKernels::getIsaName(defaultIsa), tolerance * 100.0);
+        if (useBaseline)
+            std::printf("and of every variant against %s\n", baselineFile.getFullPathName().toRawUTF8());
+
+        for (const auto &scenario : makeScenarios())
+        {
+            const auto timings = measureNanosecondsPerFrame(scenario, stimulus);
+            const double scalar = timings.at(DspKernels::Isa::scalar);
+            const double chosen = timings.at(defaultIsa);
+
+            // Dispatch must never pick kernels that lose to the scalar ones
+            const bool defaultPassed = chosen <= scalar * (1.0 + tolerance);
+            std::printf("  %-15s scalar %8.1f ns  %-6s %8.1f ns  %+6.1f%%  %s\n", scenario.name, scalar,
+                        DspKernels::getIsaName(defaultIsa), chosen, 100.0 * (chosen / scalar - 1.0),
+                        defaultPassed ? "ok" : "FAILED");
+            passed = passed && defaultPassed;
+
+            if (!useBaseline)
+                continue;
+
+            for (const auto &[isa, measured] : timings)
+            {
+                const juce::String key = juce::String(scenario.name) + " " + DspKernels::getIsaName(isa);
+                newBaseline << key << " " << juce::String(measured, 1) << "\n";
+
+                const auto entry = baseline.find(key);
+                if (regenerate || entry == baseline.end())
+                {
+                    std::printf("    %-22s %8.1f ns  %s\n", key.toRawUTF8(), measured, regenerate ? "recorded" : "no baseline");
+                    continue;
+                }
+
+                const double limit = entry->second * (1.0 + tolerance);
+                const bool keyPassed = measured <= limit;
+                std::printf("    %-22s %8.1f ns  baseline %8.1f  %+6.1f%%  %s\n", key.toRawUTF8(), measured,
+                            entry->second, 100.0 * (measured / entry->second - 1.0), keyPassed ? "ok" : "FAILED");
+                passed = passed && keyPassed;
+            }
+        }
+
+        if (regenerate && !baselineFile.replaceWithText(newBaseline))
+        {
+            std::printf("Could not write %s\n", baselineFile.getFullPathName().toRawUTF8());
+            return 1;
+        }
+
+        return passed ? 0 : 1;
+#endif
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    const auto workingDirectory = juce::File::getCurrentWorkingDirectory();
+    const auto dataDirectory = workingDirectory.getChildFile(args.getValueForOption("--data"));
+    const bool regenerate = args.containsOption("--regenerate");
+
+    int result;
+
+    if (args.containsOption("--perf"))
+    {
+        const auto toleranceOption = args.getValueForOption("--tolerance");
+        const double tolerance = toleranceOption.isEmpty() ? defaultPerfTolerance : toleranceOption.getDoubleValue();
+        const auto baselineOption = args.getValueForOption("--baseline");
+        const auto baselineFile = baselineOption.isEmpty() ? juce::File() : workingDirectory.getChildFile(baselineOption);
+        result = runPerformanceTests(baselineFile, regenerate, tolerance);
+    }
+    else
+    {
+        const bool kernelsPassed = runKernelTests();
+        const bool rendersPassed = runGoldenTests(dataDirectory, regenerate);
+        result = kernelsPassed && rendersPassed ? 0 : 1;
+    }
+
+    DspKernels::forceIsa(DspKernels::getDefaultIsa());
+    return result;
+}
@@ -0,0 +1,352 @@
+// Headless many-instance scaling harness.
+//
+// Loads N Rupture instances through the plugin entry point, spreads them
+// round-robin over M simulated audio threads and renders as fast as the
+// machine allows. For each instance count up to N it reports total CPU
+// time, resident memory per instance (measured, and as the DSP accounts
+// for it, with the optional-mode buffers not yet paged in shown apart),
+// the worst callback against the block deadline and how close throughput
+// comes to linear scaling. With --loudness it also reports the first
+// instance's output loudness and correlation, analysed on the first render
+// thread between callbacks.
+//
+//   RuptureScaling --instances=64 --threads=4 --block=128 --rate=48000
+//                  --seconds=10 --quality=high --isa=avx2 --loudness
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+#include <ctime>
+
+#if JUCE_LINUX
+#include <unistd.h>
+#elif JUCE_MAC
+#include <mach/mach.h>
+#endif
+
+juce::AudioProcessor *JUCE_CALLTYPE createPluginFilter();
+
+namespace
+{
+    struct Settings
+    {
+        int maxInstances = 16;
+        int numThreads = 1;
+        int blockSize = 128;
+        double sampleRate = 48000.0;
+        double seconds = 10.0;
+        ReverbProcessor::QualityMode qualityMode = ReverbProcessor::QualityMode::high;
+        bool measureLoudness = false;
+    };
+
+    struct RunResult
+    {
+        int numInstances = 0;
+        double wallSeconds = 0.0;
+        double cpuSeconds = 0.0;
+        double worstCallbackSeconds = 0.0;
+        size_t residentBytesPerInstance = 0;
+        size_t footprintBytesPerInstance = 0;
+        size_t lazyBytesPerInstance = 0;
+        LoudnessMeter::Measurements loudness;
+    };
+
+    // Resident set size of the whole process, or 0 where unsupported
+    size_t getResidentBytes()
+    {
+#if JUCE_LINUX
+        juce::File statm("/proc/self/statm");
+        const auto fields = juce::StringArray::fromTokens(statm.loadFileAsString(), false);
+        if (fields.size() > 1)
+            return static_cast<size_t>(fields[1].getLargeIntValue()) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#elif JUCE_MAC
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                      reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+            return static_cast<size_t>(info.resident_size);
+#endif
+        return 0;
+    }
+
+    // Process CPU time across all threads. On Windows std::clock is wall
+    // time, so the CPU column there only means something for one thread
+    double getProcessCpuSeconds()
+    {
+        return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+    }
+
+    // One simulated host audio thread rendering its share of the instances
+    // back to back each callback, the way a host does within one device period
+    class RenderThread : public juce::Thread
+    {
+    public:
+        RenderThread(int index, juce::WaitableEvent &startEvent, const Settings &settingsToUse, int numCallbacksToRun)
+            : juce::Thread("Render " + juce::String(index)),
+              start(startEvent),
+              settings(settingsToUse),
+              numCallbacks(numCallbacksToRun),
+              input(2, settingsToUse.blockSize),
+              buffer(2, settingsToUse.blockSize)
+        {
+            // Low-level noise so the tank does real work from the first block
+            juce::Random random(index + 1);
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < settings.blockSize; ++i)
+                    input.setSample(channel, i, (random.nextFloat() * 2.0f - 1.0f) * 0.25f);
+        }
+
+        void addInstance(juce::AudioProcessor &processor) { instances.add(&processor); }
+
+        // Drained after every callback, outside the timed section
+        void setLoudnessMeter(LoudnessMeter *meterToDrain) { loudnessMeter = meterToDrain; }
+
+        double getWorstCallbackSeconds() const { return worstCallbackSeconds; }
+
+        void run() override
+        {
+            juce::MidiBuffer midi;
+            start.wait();
+
+            for (int callback = 0; callback < numCallbacks && !threadShouldExit(); ++callback)
+            {
+                const auto startTicks = juce::Time::getHighResolutionTicks();
+
+                for (auto *processor : instances)
+                {
+                    buffer.makeCopyOf(input, true);
+                    processor->processBlock(buffer, midi);
+                }
+
+                const auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+                worstCallbackSeconds = juce::jmax(worstCallbackSeconds, elapsed);
+
+                // Rendering outruns realtime, so the tap has to be drained every callback
+                if (loudnessMeter != nullptr)
+                    loudnessMeter->process();
+            }
+        }
+
+    private:
+        juce::WaitableEvent &start;
+        const Settings &settings;
+        const int numCallbacks;
+
+        juce::AudioBuffer<float> input, buffer;
+        juce::Array<juce::AudioProcessor *> instances;
+        LoudnessMeter *loudnessMeter = nullptr;
+        double worstCallbackSeconds = 0.0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderThread)
+    };
+
+    RunResult runWithInstances(const Settings &settings, int numInstances)
+    {
+        RunResult result;
+        result.numInstances = numInstances;
+
+        // Memory is measured across creation and prepare, which is where
+        // every allocation an instance keeps is made
+        const size_t residentBefore = getResidentBytes();
+
+        juce::OwnedArray<juce::AudioProcessor> instances;
+        size_t footprintTotal = 0;
+        size_t lazyTotal = 0;
+
+        for (int i = 0; i < numInstances; ++i)
+        {
+            auto *processor = instances.add(createPluginFilter());
+            processor->setPlayConfigDetails(2, 2, settings.sampleRate, settings.blockSize);
+            processor->setNonRealtime(false);
+            processor->prepareToPlay(settings.sampleRate, settings.blockSize);
+
+            if (auto *rupture = dynamic_cast<RuptureAudioProcessor *>(processor))
+            {
+                rupture->getReverbProcessor().setQualityMode(settings.qualityMode);
+                const auto footprint = rupture->getMemoryFootprint();
+                footprintTotal += footprint.getResidentBytes();
+                lazyTotal += footprint.optionalBytes - footprint.optionalResidentBytes;
+            }
+        }
+
+        const size_t residentAfter = getResidentBytes();
+        if (residentAfter > residentBefore)
+            result.residentBytesPerInstance = (residentAfter - residentBefore) / static_cast<size_t>(numInstances);
+        result.footprintBytesPerInstance = footprintTotal / static_cast<size_t>(numInstances);
+        result.lazyBytesPerInstance = lazyTotal / static_cast<size_t>(numInstances);
+
+        const int numCallbacks = juce::jmax(1, juce::roundToInt(settings.seconds * settings.sampleRate / settings.blockSize));
+        const int numThreads = juce::jmin(settings.numThreads, numInstances);
+
+        juce::WaitableEvent startEvent(true);
+        juce::OwnedArray<RenderThread> threads;
+
+        for (int i = 0; i < numThreads; ++i)
+            threads.add(new RenderThread(i, startEvent, settings, numCallbacks));
+
+        for (int i = 0; i < numInstances; ++i)
+            threads[i % numThreads]->addInstance(*instances[i]);
+
+        auto *firstRupture = dynamic_cast<RuptureAudioProcessor *>(instances[0]);
+        if (settings.measureLoudness && firstRupture != nullptr)
+        {
+            firstRupture->setLoudnessMetering(true);
+            threads[0]->setLoudnessMeter(&firstRupture->getLoudnessMeter());
+        }
+
+        for (auto *thread : threads)
+            thread->startRealtimeThread(juce::Thread::RealtimeOptions{}.withPriority(8));
+
+        // Give every thread a moment to reach the start line before timing
+        juce::Thread::sleep(50);
+
+        const double cpuStart = getProcessCpuSeconds();
+        const auto wallStart = juce::Time::getHighResolutionTicks();
+        startEvent.signal();
+
+        for (auto *thread : threads)
+            thread->waitForThreadToExit(-1);
+
+        result.wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - wallStart);
+        result.cpuSeconds = getProcessCpuSeconds() - cpuStart;
+
+        for (auto *thread : threads)
+            result.worstCallbackSeconds = juce::jmax(result.worstCallbackSeconds, thread->getWorstCallbackSeconds());
+
+        if (settings.measureLoudness && firstRupture != nullptr)
+        {
+            firstRupture->getLoudnessMeter().process();
+            result.loudness = firstRupture->getLoudnessMeter().getMeasurements();
+        }
+
+        for (auto *processor : instances)
+            processor->releaseResources();
+
+        return result;
+    }
+
+    bool parseQualityMode(const juce::String &name, ReverbProcessor::QualityMode &mode)
+    {
+        const juce::StringArray names{"eco", "normal", "high", "auto"};
+        const int index = names.indexOf(name, true);
+        if (index < 0)
+            return false;
+
+        mode = static_cast<ReverbProcessor::QualityMode>(index);
+        return true;
+    }
+
+    bool parseIsa(const juce::String &name, DspKernels::Isa &isa)
+    {
+        for (auto candidate : {DspKernels::Isa::scalar, DspKernels::Isa::sse2,
+                               DspKernels::Isa::avx2, DspKernels::Isa::avx512})
+        {
+            if (name.equalsIgnoreCase(DspKernels::getIsaName(candidate)))
+            {
+                isa = candidate;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void printUsage()
+    {
+        std::printf("Usage: RuptureScaling [--instances=N] [--threads=M] [--block=SAMPLES]\n"
+                    "                      [--rate=HZ] [--seconds=S] [--quality=eco|normal|high|auto]\n"
+                    "                      [--isa=scalar|sse2|avx2|avx512] [--loudness]\n");
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList args(argc, argv);
+
+    if (args.containsOption("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    Settings settings;
+    const auto getInt = [&args](const char *option, int fallback)
+    {
+        const auto value = args.getValueForOption(option);
+        return value.isEmpty() ? fallback : value.getIntValue();
+    };
+
+    settings.maxInstances = juce::jmax(1, getInt("--instances", settings.maxInstances));
+    settings.numThreads = juce::jmax(1, getInt("--threads", settings.numThreads));
+    settings.blockSize = juce::jmax(1, getInt("--block", settings.blockSize));
+    settings.sampleRate = juce::jmax(8000, getInt("--rate", juce::roundToInt(settings.sampleRate)));
+
+    settings.measureLoudness = args.containsOption("--loudness");
+
+    if (args.containsOption("--seconds"))
+        settings.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+
+    if (args.containsOption("--quality") && !parseQualityMode(args.getValueForOption("--quality"), settings.qualityMode))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (args.containsOption("--isa"))
+    {
+        DspKernels::Isa isa;
+        if (!parseIsa(args.getValueForOption("--isa"), isa) || !DspKernels::forceIsa(isa))
+        {
+            std::printf("ISA '%s' is unknown or not supported on this CPU\n",
+                        args.getValueForOption("--isa").toRawUTF8());
+            return 1;
+        }
+    }
+
+    const double deadlineSeconds = settings.blockSize / settings.sampleRate;
+
+    std::printf("Rupture scaling: up to %d instances on %d threads, %d samples at %.0f Hz (%.3f ms deadline), "
+                "%.1f s per run, kernels %s\n\n",
+                settings.maxInstances, settings.numThreads, settings.blockSize, settings.sampleRate,
+                deadlineSeconds * 1000.0, settings.seconds, DspKernels::getIsaName(DspKernels::get().isa));
+
+    std::printf("%9s %10s %10s %12s %12s %13s %12s %10s %10s",
+                "instances", "wall s", "cpu s", "rss KiB/inst", "dsp KiB/inst", "lazy KiB/inst", "worst ms", "worst %", "scaling");
+    if (settings.measureLoudness)
+        std::printf(" %8s %8s %8s %6s", "M LUFS", "S LUFS", "I LUFS", "corr");
+    std::printf("\n");
+
+    double singleThroughput = 0.0;
+
+    // Double the count each run, always finishing on the requested maximum
+    for (int numInstances = 1;; numInstances = juce::jmin(numInstances * 2, settings.maxInstances))
+    {
+        const auto result = runWithInstances(settings, numInstances);
+
+        // Instance-seconds of audio rendered per wall-clock second
+        const double throughput = numInstances * settings.seconds / juce::jmax(1.0e-9, result.wallSeconds);
+        if (numInstances == 1)
+            singleThroughput = throughput;
+
+        const int parallelism = juce::jmin(numInstances, settings.numThreads);
+        const double efficiency = throughput / (singleThroughput * parallelism);
+
+        std::printf("%9d %10.3f %10.3f %12.1f %12.1f %13.1f %12.3f %9.1f%% %9.1f%%",
+                    numInstances, result.wallSeconds, result.cpuSeconds,
+                    result.residentBytesPerInstance / 1024.0, result.footprintBytesPerInstance / 1024.0,
+                    result.lazyBytesPerInstance / 1024.0,
+                    result.worstCallbackSeconds * 1000.0, 100.0 * result.worstCallbackSeconds / deadlineSeconds,
+                    100.0 * efficiency);
+        if (settings.measureLoudness)
+            std::printf(" %8.1f %8.1f %8.1f %6.2f", result.loudness.momentary, result.loudness.shortTerm,
+                        result.loudness.integrated, result.loudness.correlation);
+        std::printf("\n");
+        std::fflush(stdout);
+
+        if (numInstances >= settings.maxInstances)
+            break;
+    }
+
+    return 0;
+}
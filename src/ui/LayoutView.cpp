@@ -13,6 +13,16 @@ bool LayoutView::LayoutMessageHandler::pageAboutToLoad(const juce::String &url)
     {
         juce::String params = url.fromFirstOccurrenceOf("rupture:", false, true);
 
+        // Page lifecycle
+        if (params == "ui:ready")
+        {
+            ownerView.handlePageReady();
+            return false;
+        }
+
+        if (ownerView.onInteraction != nullptr)
+            ownerView.onInteraction();
+
         // Handle reverb parameters
         if (params.startsWith("reverb:"))
         {
@@ -54,6 +64,138 @@ bool LayoutView::LayoutMessageHandler::pageAboutToLoad(const juce::String &url)
                 ownerView.reverbProcessor.setFreezeMode(value);
                 return false;
             }
+            else if (params.startsWith("captureFreeze="))
+            {
+                float value = params.fromFirstOccurrenceOf("captureFreeze=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setCaptureFreeze(value >= 0.5f);
+                return false;
+            }
+            else if (params.startsWith("qualityMode="))
+            {
+                int value = juce::jlimit(0, 3, params.fromFirstOccurrenceOf("qualityMode=", false, true).getIntValue());
+                ownerView.reverbProcessor.setQualityMode(static_cast<ReverbProcessor::QualityMode>(value));
+                return false;
+            }
+            else if (params.startsWith("halfRateTail="))
+            {
+                float value = params.fromFirstOccurrenceOf("halfRateTail=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setHalfRateTail(value >= 0.5f);
+                return false;
+            }
+            else if (params.startsWith("lowCut="))
+            {
+                float value = params.fromFirstOccurrenceOf("lowCut=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setLowCut(value);
+                return false;
+            }
+            else if (params.startsWith("highCut="))
+            {
+                float value = params.fromFirstOccurrenceOf("highCut=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setHighCut(value);
+                return false;
+            }
+            else if (params.startsWith("tilt="))
+            {
+                float value = params.fromFirstOccurrenceOf("tilt=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setTilt(value);
+                return false;
+            }
+            else if (params.startsWith("shimmer="))
+            {
+                float value = params.fromFirstOccurrenceOf("shimmer=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setShimmerAmount(value);
+                return false;
+            }
+            else if (params.startsWith("shimmerPitch="))
+            {
+                float value = params.fromFirstOccurrenceOf("shimmerPitch=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setShimmerPitch(value);
+                return false;
+            }
+            else if (params.startsWith("drive="))
+            {
+                float value = params.fromFirstOccurrenceOf("drive=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setDrive(value);
+                return false;
+            }
+            else if (params.startsWith("driveOversampling="))
+            {
+                int value = params.fromFirstOccurrenceOf("driveOversampling=", false, true).getIntValue();
+                ownerView.reverbProcessor.setDriveOversampling(value);
+                return false;
+            }
+            else if (params.startsWith("tailMode="))
+            {
+                int value = juce::jlimit(0, 2, params.fromFirstOccurrenceOf("tailMode=", false, true).getIntValue());
+                ownerView.reverbProcessor.setTailMode(static_cast<ReverbProcessor::TailMode>(value));
+                return false;
+            }
+            else if (params.startsWith("reverseLength="))
+            {
+                float value = params.fromFirstOccurrenceOf("reverseLength=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setReverseLength(value);
+                return false;
+            }
+            else if (params.startsWith("gateThreshold="))
+            {
+                float value = params.fromFirstOccurrenceOf("gateThreshold=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setGateThreshold(value);
+                return false;
+            }
+            else if (params.startsWith("gateHold="))
+            {
+                float value = params.fromFirstOccurrenceOf("gateHold=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setGateHold(value);
+                return false;
+            }
+            else if (params.startsWith("duckAmount="))
+            {
+                float value = params.fromFirstOccurrenceOf("duckAmount=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setDuckAmount(value);
+                return false;
+            }
+            else if (params.startsWith("duckThreshold="))
+            {
+                float value = params.fromFirstOccurrenceOf("duckThreshold=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setDuckThreshold(value);
+                return false;
+            }
+            else if (params.startsWith("duckRelease="))
+            {
+                float value = params.fromFirstOccurrenceOf("duckRelease=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setDuckRelease(value);
+                return false;
+            }
+            else if (params.startsWith("midSideMode="))
+            {
+                float value = params.fromFirstOccurrenceOf("midSideMode=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setMidSideMode(value >= 0.5f);
+                return false;
+            }
+            else if (params.startsWith("sideRoomSize="))
+            {
+                float value = params.fromFirstOccurrenceOf("sideRoomSize=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setSideRoomSize(value);
+                return false;
+            }
+            else if (params.startsWith("sideDamping="))
+            {
+                float value = params.fromFirstOccurrenceOf("sideDamping=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setSideDamping(value);
+                return false;
+            }
+            else if (params.startsWith("midLevel="))
+            {
+                float value = params.fromFirstOccurrenceOf("midLevel=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setMidLevel(value);
+                return false;
+            }
+            else if (params.startsWith("sideLevel="))
+            {
+                float value = params.fromFirstOccurrenceOf("sideLevel=", false, true).getFloatValue();
+                ownerView.reverbProcessor.setSideLevel(value);
+                return false;
+            }
         }
 
         return false; // We handled this URL
@@ -98,6 +240,12 @@ LayoutView::LayoutView(ReverbProcessor &revProc)
       pageLoaded(false),
       lastLeftLevel(0.0f),
       lastRightLevel(0.0f),
+      lastOutLeftLevel(0.0f),
+      lastOutRightLevel(0.0f),
+      lastMomentary(0.0f),
+      lastShortTerm(0.0f),
+      lastIntegrated(0.0f),
+      lastCorrelation(0.0f),
       lastRoomSize(revProc.getRoomSize()),
       lastDamping(revProc.getDamping()),
       lastWetLevel(revProc.getWetLevel()),
@@ -117,16 +265,12 @@ LayoutView::LayoutView(ReverbProcessor &revProc)
         "<link rel=\"stylesheet\" href=\"./layout.css\" />",
         "<style>\n" + cssContent + "\n    </style>");
 
-    // Load the combined HTML content
+    // Load the combined HTML content; updates start once it reports ready
     webView->goToURL("data:text/html;charset=utf-8," + htmlContent);
-
-    // Start timer for updates
-    startTimerHz(30);
 }
 
 LayoutView::~LayoutView()
 {
-    stopTimer();
     webView = nullptr;
 }
 
@@ -141,23 +285,24 @@ void LayoutView::resized()
     webView->setBounds(getLocalBounds());
 }
 
-void LayoutView::timerCallback()
+void LayoutView::handlePageReady()
 {
-    // First few cycles, just wait for page to load
-    static int pageLoadCounter = 0;
-    if (!pageLoaded)
-    {
-        pageLoadCounter++;
-        if (pageLoadCounter >= 10) // About 333ms with 30Hz timer
-        {
-            pageLoaded = true;
+    if (pageLoaded)
+        return;
 
-            // Initialize with default values
-            juce::String script = "window.setAudioState(0, 0, 0, 0)";
-            webView->evaluateJavascript(script);
-        }
+    pageLoaded = true;
+
+    // Initialize with the processor's values
+    refreshAllParameters();
+
+    if (onPageReady != nullptr)
+        onPageReady();
+}
+
+void LayoutView::syncParameters()
+{
+    if (!pageLoaded)
         return;
-    }
 
     // Check for parameter changes in reverb processor
     float roomSize = reverbProcessor.getRoomSize();
@@ -193,12 +338,15 @@ void LayoutView::timerCallback()
         lastWidth = width;
         lastFreezeMode = freezeMode;
     }
-}
 
-void LayoutView::updateBuffer(const juce::AudioBuffer<float> &buffer)
-{
-    // We're not using the oscilloscope anymore, but we'll keep this method
-    // to maintain compatibility with existing code that calls it
+    // Module parameters
+    juce::String moduleValues = getModuleValuesScript();
+
+    if (moduleValues != lastModuleValues)
+    {
+        webView->evaluateJavascript(moduleValues);
+        lastModuleValues = moduleValues;
+    }
 }
 
 void LayoutView::updateLevels(float leftLevel, float rightLevel, float outLeftLevel, float outRightLevel)
@@ -206,10 +354,6 @@ void LayoutView::updateLevels(float leftLevel, float rightLevel, float outLeftLe
     if (!pageLoaded)
         return;
 
-    // Store the last known levels
-    lastLeftLevel = leftLevel;
-    lastRightLevel = rightLevel;
-
     // If signal is very close to zero, explicitly set it to zero
     if (leftLevel < 0.01f)
         leftLevel = 0.0f;
@@ -220,6 +364,17 @@ void LayoutView::updateLevels(float leftLevel, float rightLevel, float outLeftLe
     if (outRightLevel < 0.01f)
         outRightLevel = 0.0f;
 
+    // Silence and steady levels need no new frame
+    if (leftLevel == lastLeftLevel && rightLevel == lastRightLevel &&
+        outLeftLevel == lastOutLeftLevel && outRightLevel == lastOutRightLevel)
+        return;
+
+    // Store the last known levels
+    lastLeftLevel = leftLevel;
+    lastRightLevel = rightLevel;
+    lastOutLeftLevel = outLeftLevel;
+    lastOutRightLevel = outRightLevel;
+
     try
     {
         // Ensure values are valid by using String conversion with proper formatting
@@ -238,6 +393,29 @@ void LayoutView::updateLevels(float leftLevel, float rightLevel, float outLeftLe
     }
 }
 
+void LayoutView::updateLoudness(float momentary, float shortTerm, float integrated, float correlation)
+{
+    if (!pageLoaded)
+        return;
+
+    // The readout shows one decimal place, so smaller changes aren't worth a frame
+    if (std::abs(momentary - lastMomentary) < 0.05f && std::abs(shortTerm - lastShortTerm) < 0.05f &&
+        std::abs(integrated - lastIntegrated) < 0.05f && std::abs(correlation - lastCorrelation) < 0.005f)
+        return;
+
+    lastMomentary = momentary;
+    lastShortTerm = shortTerm;
+    lastIntegrated = integrated;
+    lastCorrelation = correlation;
+
+    juce::String script = "window.setLoudness(" +
+                          juce::String(momentary, 1) + ", " +
+                          juce::String(shortTerm, 1) + ", " +
+                          juce::String(integrated, 1) + ", " +
+                          juce::String(correlation, 2) + ")";
+    webView->evaluateJavascript(script);
+}
+
 void LayoutView::refreshAllParameters()
 {
     // Force an immediate refresh of all parameters
@@ -266,6 +444,45 @@ void LayoutView::refreshAllParameters()
         lastFreezeMode = freezeMode;
     }
 
-    // Update levels
-    updateLevels(lastLeftLevel, lastRightLevel, 0.0f, 0.0f);
+    // Module parameters
+    lastModuleValues = getModuleValuesScript();
+    webView->evaluateJavascript(lastModuleValues);
+
+    // Update levels, sending them even though they haven't changed
+    const float leftLevel = lastLeftLevel;
+    const float rightLevel = lastRightLevel;
+    lastLeftLevel = -1.0f;
+    updateLevels(leftLevel, rightLevel, 0.0f, 0.0f);
+}
+
+juce::String LayoutView::getModuleValuesScript() const
+{
+    const auto flag = [](bool value) { return value ? 1.0f : 0.0f; };
+
+    juce::DynamicObject::Ptr values = new juce::DynamicObject();
+    values->setProperty("captureFreeze", flag(reverbProcessor.getCaptureFreeze()));
+    values->setProperty("halfRateTail", flag(reverbProcessor.getHalfRateTail()));
+    values->setProperty("qualityMode", static_cast<int>(reverbProcessor.getQualityMode()));
+    values->setProperty("lowCut", reverbProcessor.getLowCut());
+    values->setProperty("highCut", reverbProcessor.getHighCut());
+    values->setProperty("tilt", reverbProcessor.getTilt());
+    values->setProperty("shimmer", reverbProcessor.getShimmerAmount());
+    values->setProperty("shimmerPitch", reverbProcessor.getShimmerPitch());
+    values->setProperty("drive", reverbProcessor.getDrive());
+    values->setProperty("driveOversampling", reverbProcessor.getDriveOversampling());
+    values->setProperty("tailMode", static_cast<int>(reverbProcessor.getTailMode()));
+    values->setProperty("reverseLength", reverbProcessor.getReverseLength());
+    values->setProperty("gateThreshold", reverbProcessor.getGateThreshold());
+    values->setProperty("gateHold", reverbProcessor.getGateHold());
+    values->setProperty("duckAmount", reverbProcessor.getDuckAmount());
+    values->setProperty("duckThreshold", reverbProcessor.getDuckThreshold());
+    values->setProperty("duckRelease", reverbProcessor.getDuckRelease());
+    values->setProperty("midSideMode", flag(reverbProcessor.getMidSideMode()));
+    values->setProperty("sideRoomSize", reverbProcessor.getSideRoomSize());
+    values->setProperty("sideDamping", reverbProcessor.getSideDamping());
+    values->setProperty("midLevel", reverbProcessor.getMidLevel());
+    values->setProperty("sideLevel", reverbProcessor.getSideLevel());
+
+    // Three decimals is finer than a knob step, and keeps float noise from resending
+    return "window.setModuleValues(" + juce::JSON::toString(juce::var(values.get()), true, 3) + ")";
 }
\ No newline at end of file
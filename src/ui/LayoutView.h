@@ -3,8 +3,7 @@
 #include <JuceHeader.h>
 #include "ReverbProcessor.h"
 
-class LayoutView : public juce::Component,
-                   private juce::Timer
+class LayoutView : public juce::Component
 {
 public:
     LayoutView(ReverbProcessor &reverbProcessor);
@@ -13,15 +12,24 @@ public:
     void paint(juce::Graphics &g) override;
     void resized() override;
 
-    // Update audio buffer for level metering
-    void updateBuffer(const juce::AudioBuffer<float> &buffer);
-
-    // Update levels for meters
+    // Update levels for meters; unchanged levels aren't sent to the page again
     void updateLevels(float leftLevel, float rightLevel, float outLeftLevel, float outRightLevel);
 
+    // Loudness readout in LUFS, plus phase correlation (-1 - +1)
+    void updateLoudness(float momentary, float shortTerm, float integrated, float correlation);
+
+    // Push reverb parameters changed outside the page (e.g. by a preset load)
+    void syncParameters();
+
     // Force a refresh of all UI parameters
     void refreshAllParameters();
 
+    // Called once the page has loaded and can take updates
+    std::function<void()> onPageReady;
+
+    // Called for every control message from the page
+    std::function<void()> onInteraction;
+
     // URL handler for callbacks from JS
     class LayoutMessageHandler : public juce::WebBrowserComponent
     {
@@ -44,6 +52,14 @@ private:
     // Input/Output levels
     float lastLeftLevel;
     float lastRightLevel;
+    float lastOutLeftLevel;
+    float lastOutRightLevel;
+
+    // Loudness readout
+    float lastMomentary;
+    float lastShortTerm;
+    float lastIntegrated;
+    float lastCorrelation;
 
     // Reverb parameters
     float lastRoomSize;
@@ -53,8 +69,14 @@ private:
     float lastWidth;
     float lastFreezeMode;
 
-    // Timer callback for UI updates
-    void timerCallback() override;
+    // Module parameters as last sent to the page
+    juce::String lastModuleValues;
+
+    // Script passing every module parameter to the page, keyed by message name
+    juce::String getModuleValuesScript() const;
+
+    // The page signals it's ready from its load handler
+    void handlePageReady();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LayoutView)
 };
\ No newline at end of file
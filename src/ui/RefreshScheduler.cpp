@@ -0,0 +1,78 @@
+#include "RefreshScheduler.h"
+
+RefreshScheduler::RefreshScheduler(juce::Component &editorToWatch, std::function<bool()> refreshCallback)
+    : juce::ComponentMovementWatcher(&editorToWatch),
+      editor(editorToWatch),
+      refresh(std::move(refreshCallback))
+{
+}
+
+RefreshScheduler::~RefreshScheduler()
+{
+    stopTimer();
+}
+
+void RefreshScheduler::setPageReady()
+{
+    pageReady = true;
+    wake();
+}
+
+void RefreshScheduler::noteInteraction()
+{
+    lastInteractionSeconds = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    active = true;
+    updateRate();
+}
+
+void RefreshScheduler::wake()
+{
+    active = true;
+    updateRate();
+}
+
+void RefreshScheduler::timerCallback()
+{
+    active = refresh();
+    updateRate();
+}
+
+void RefreshScheduler::updateRate()
+{
+    const double now = juce::Time::getMillisecondCounterHiRes() * 0.001;
+    const bool interacting = now - lastInteractionSeconds < interactionHoldSeconds;
+
+    int rateHz = 0;
+    if (pageReady && editor.isShowing())
+    {
+        if (interacting)
+            rateHz = interactiveRateHz;
+        else if (active)
+            rateHz = idleRateHz;
+    }
+
+    if (rateHz == currentRateHz)
+        return;
+
+    currentRateHz = rateHz;
+
+    if (rateHz > 0)
+        startTimerHz(rateHz);
+    else
+        stopTimer();
+}
+
+void RefreshScheduler::componentMovedOrResized(bool, bool)
+{
+}
+
+void RefreshScheduler::componentPeerChanged()
+{
+    wake();
+}
+
+void RefreshScheduler::componentVisibilityChanged()
+{
+    // Catch up on anything missed while hidden
+    wake();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+// Drives all of one editor's UI refreshes from a single timer whose rate
+// follows what the user is doing: fast while they interact, slow while the
+// meters are merely moving, and stopped while the editor is hidden or there
+// is nothing left to show. A stopped scheduler restarts on wake(), so the
+// processor must call it (via the editor) when sound resumes.
+class RefreshScheduler : private juce::Timer,
+                         private juce::ComponentMovementWatcher
+{
+public:
+    static constexpr int interactiveRateHz = 60;
+    static constexpr int idleRateHz = 5;
+
+    // The callback refreshes the UI and returns whether anything shown is
+    // still changing (e.g. a meter that hasn't emptied yet)
+    RefreshScheduler(juce::Component &editorToWatch, std::function<bool()> refreshCallback);
+    ~RefreshScheduler() override;
+
+    // Nothing is refreshed until the page says it can take updates
+    void setPageReady();
+
+    // Holds the interactive rate for a moment after each user action
+    void noteInteraction();
+
+    // Restarts refreshing after the UI went quiet, e.g. when sound resumes
+    // or a preset is loaded while stopped
+    void wake();
+
+private:
+    // How long the interactive rate outlives the last interaction
+    static constexpr double interactionHoldSeconds = 1.0;
+
+    void timerCallback() override;
+
+    // Picks the rate for the current state and restarts the timer if it changed
+    void updateRate();
+
+    // ComponentMovementWatcher, for visibility of the editor or any parent
+    void componentMovedOrResized(bool wasMoved, bool wasResized) override;
+    void componentPeerChanged() override;
+    void componentVisibilityChanged() override;
+    using juce::ComponentMovementWatcher::componentVisibilityChanged;
+
+    juce::Component &editor;
+    std::function<bool()> refresh;
+
+    bool pageReady = false;
+    bool active = true;
+    double lastInteractionSeconds = -interactionHoldSeconds;
+    int currentRateHz = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RefreshScheduler)
+};